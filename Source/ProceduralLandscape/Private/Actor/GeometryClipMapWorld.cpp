@@ -10,12 +10,19 @@
 #include "DrawDebugHelpers.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Async/ParallelFor.h"
+#include "Async/Async.h"
 #include "Kismet/KismetRenderingLibrary.h"
 #include "Engine/AutoDestroySubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Component/GeoClipmapMeshComponent.h"
+#include "Component/GeoClipmapRingGeometry.h"
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#include "Materials/MaterialFunctionInterface.h"
+#include "Noise/GeoClipmapMaterialTranslator.h"
+#endif
 
 /*
 static int32 GUseStreamingManagerForCameras = 0;
@@ -76,7 +83,7 @@ void AGeometryClipMapWorld::Setup()
 
 	UpdateCameraLocation();
 
-	if (GenerateCollision_last != GenerateCollision || VerticalRangeMeters_last != VerticalRangeMeters || Caching_last != EnableCaching)
+	if (GenerateCollision_last != GenerateCollision || HeightfieldCollision_last != HeightfieldCollision || VerticalRangeMeters_last != VerticalRangeMeters || Caching_last != EnableCaching || CompactVertices_last != CompactVertices || CacheHeightBounds_last != CacheHeightBounds || CacheMatPacksHeight_last != CacheMatPacksHeight || WorldPresentation_last != WorldPresentation)
 		rebuild = true;
 
 
@@ -85,13 +92,7 @@ void AGeometryClipMapWorld::Setup()
 		for (int i = Meshes.Num() - 1; i >= 0; i--)
 		{
 			FClipMapMeshElement& Elem = Meshes[i];
-			if (Elem.Mesh)
-			{
-				Elem.Mesh->ClearAllMeshSections();
-				Elem.Mesh->UnregisterComponent();
-				Elem.Mesh->DestroyComponent();
-				Elem.Mesh = nullptr;				
-			}
+			Elem.Mesh = nullptr;
 			if (Elem.I_Mesh)
 			{
 				Elem.I_Mesh->ClearInstances();
@@ -106,6 +107,16 @@ void AGeometryClipMapWorld::Setup()
 
 		Meshes.Empty();
 
+		if (ClipMapMesh)
+		{
+			ClipMapMesh->ClearAllMeshSections();
+			ClipMapMesh->UnregisterComponent();
+			ClipMapMesh->DestroyComponent();
+			ClipMapMesh = nullptr;
+		}
+
+		RingGeometry.Reset();
+
 		for (int i = CollisionMesh.Num() - 1; i >= 0; i--)
 		{
 			FCollisionMeshElement& Elem = CollisionMesh[i];
@@ -115,14 +126,24 @@ void AGeometryClipMapWorld::Setup()
 				Elem.Mesh->UnregisterComponent();
 				Elem.Mesh->DestroyComponent();
 				Elem.Mesh = nullptr;
-				Elem.CollisionRT = nullptr;
 			}
+			if (Elem.Heightfield)
+			{
+				Elem.Heightfield->UnregisterComponent();
+				Elem.Heightfield->DestroyComponent();
+				Elem.Heightfield = nullptr;
+			}
+			Elem.CollisionRT = nullptr;
 
 		}
 
 		CollisionMesh.Empty();
 		AvailableCollisionMesh.Empty();
 		UsedCollisionMesh.Empty();
+		// Reads in flight keep their slot alive until the render thread is done with it
+		CollisionReadbacks.Empty();
+		CollisionReadQueued.Empty();
+		CollisionReadToProcess.Empty();
 		GroundCollisionLayout.Empty();
 
 		for (FSpawnableMesh& Spawnable : Spawnables)
@@ -132,8 +153,13 @@ void AGeometryClipMapWorld::Setup()
 
 		rebuild = false;
 		GenerateCollision_last = GenerateCollision;
+		HeightfieldCollision_last = HeightfieldCollision;
 		VerticalRangeMeters_last = VerticalRangeMeters;
 		Caching_last = EnableCaching;
+		CompactVertices_last = CompactVertices;
+		CacheHeightBounds_last = CacheHeightBounds;
+		CacheMatPacksHeight_last = CacheMatPacksHeight;
+		WorldPresentation_last = WorldPresentation;
 	}
 
 	if(rebuildVegetationOnly)
@@ -152,13 +178,17 @@ void AGeometryClipMapWorld::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 	
 	
+	PollCollisionReads();
+
+	ProcessCollisionsPending();
+
 	if(RTUpdate.IsFenceComplete())
 	{
-		ProcessCollisionsPending();
-
 		ProcessSpawnablePending();		
 	}
 
+	ProcessHeightBoundsPending();
+
 	TimeAcu+=DeltaTime;
 	
 	if(!(TimeAcu>1.0/(FMath::Clamp(UpdateRatePerSecond,1.f,200.f))) || !RTUpdate.IsFenceComplete())
@@ -201,10 +231,37 @@ void AGeometryClipMapWorld::PostEditChangeProperty(FPropertyChangedEvent& Proper
 		{
 			rebuild=true;
 		}
+		else if(PropName == TEXT("CPUHeightFunction"))
+		{
+			TranslateCPUHeightFunction();
+		}
 	}
 
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 }
+
+void AGeometryClipMapWorld::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	// The material graph is editor only data, cooked builds only get the translated program
+	TranslateCPUHeightFunction();
+
+	Super::PreSave(ObjectSaveContext);
+}
+
+void AGeometryClipMapWorld::TranslateCPUHeightFunction()
+{
+	if (!CPUHeightFunction)
+	{
+		CPUHeightProgram.Reset();
+		return;
+	}
+
+	FString Error;
+	if (!FGeoClipmapMaterialTranslator::Translate(CPUHeightFunction, CPUHeightProgram, Error))
+	{
+		UE_LOG(LogTemp,Warning,TEXT("%s can't be evaluated on the CPU : %s"),*CPUHeightFunction->GetName(),*Error);
+	}
+}
 #endif
 
 void AGeometryClipMapWorld::SetN()
@@ -224,308 +281,6 @@ bool AGeometryClipMapWorld::CanUpdateSpawnables()
 	return false;
 }
 
-void AGeometryClipMapWorld::CreateGridMeshWelded(int LOD, int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs,TArray<FVector2D>& UV1s,TArray<FVector2D>& UV2s, float& GridSpacing_,FVector& Offset, uint8 StitchProfil)
-{
-	bool StitchX0 = (((StitchProfil>>3) & 1) > 0);
-	bool StitchXN = (((StitchProfil>>2) & 1) > 0);
-
-	bool StitchY0 = (((StitchProfil >> 1) & 1) > 0);
-	bool StitchYN = ((StitchProfil & 1) > 0);
-	
-
-	int IDOffset = Vertices.Num();
-
-	FVector Loc = GetActorLocation();
-
-	if (NumX >= 2 && NumY >= 2)
-	{
-		FVector2D Extent = FVector2D(Offset.X,Offset.Y);
-
-		for (int i = 0; i < NumY; i++)
-		{
-			for (int j = 0; j < NumX; j++)
-			{
-				FVector PosVertex = FVector((float)j * GridSpacing_ + Extent.X, (float)i * GridSpacing_ + Extent.Y, 0);
-
-				Vertices.Add(PosVertex + FVector(0.f,0.f,1.f)*VerticalRangeMeters*100.f * ((i+j)%2==0?1.f:-1.f));
-
-				UVs.Add(FVector2D(FMath::Frac(PosVertex.X/400000.f), FMath::Frac(PosVertex.Y/400000.f)));
-
-				UV1s.Add(FVector2D(PosVertex.X/GridSpacing_, PosVertex.Y/GridSpacing_));
-
-				UV2s.Add(FVector2D((i>0 && i<NumY-1)&&(j>0 && j<NumX-1)?1.f:0.f,0.f));
-			
-				
-			}
-		}
-
-		for (int i = 0; i < NumY - 1; i++)
-		{
-			for (int j = 0; j < NumX - 1; j++)
-			{
-				int idx = j + (i * NumX) + IDOffset;
-
-				if(i>0 && i<NumY - 2 && j>0 && j<NumX - 2 || NumX==2 || NumY==2|| !StitchX0 && !StitchXN && !StitchY0 && !StitchYN)
-				{
-					Triangles.Add(idx);
-					Triangles.Add(idx + NumX);
-					Triangles.Add(idx + 1);
-
-					Triangles.Add(idx + 1);
-					Triangles.Add(idx + NumX);
-					Triangles.Add(idx + NumX + 1);
-				}
-				else
-				{
-					if(i==0)
-					{
-						if (StitchY0)
-						{
-							if (j % 2 == 0 && j < NumX - 2)
-							{
-								if (j>0)
-								{
-									Triangles.Add(idx);
-									Triangles.Add(idx + NumX);
-									Triangles.Add(idx + 1 + NumX);
-								}
-
-								Triangles.Add(idx);
-								Triangles.Add(idx + 1 + NumX);
-								Triangles.Add(idx + 2);
-
-								if(j+2<NumX - 2)
-								{
-									Triangles.Add(idx + 2);
-									Triangles.Add(idx + 1 + NumX);
-									Triangles.Add(idx + 2 + NumX);
-								}								
-
-							}
-						}
-						else
-						{
-							
-							if(j==0 && StitchX0)
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + 1 + NumX);
-								Triangles.Add(idx + 1);
-							}
-							else if (j == NumX - 2)
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1);
-							}
-							else
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1);
-
-								Triangles.Add(idx + 1);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + NumX + 1);
-							}
-							
-							
-						}
-					}
-					if (i == NumY - 2)
-					{
-						if (StitchYN)
-						{
-							if (j % 2 == 0 && j < NumX - 2)
-							{
-								if (j > 0)
-								{
-									Triangles.Add(idx);
-									Triangles.Add(idx + NumX);
-									Triangles.Add(idx + 1);
-								}
-
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 2 + NumX);
-								Triangles.Add(idx + 1);
-
-								if (j + 2 < NumX - 2)
-								{
-									Triangles.Add(idx + 1);
-									Triangles.Add(idx + 2 + NumX);
-									Triangles.Add(idx + 2);
-								}
-
-							}
-						}
-						else
-						{
-							
-							if (j == 0)
-							{
-								Triangles.Add(idx + 1);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + NumX + 1);
-							}
-							else if (j == NumX - 2 && StitchXN)
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1 + NumX);
-							}
-							else
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1);
-
-								Triangles.Add(idx + 1);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + NumX + 1);
-							}
-							
-						}
-					}
-					if (j == 0)
-					{
-						if(StitchX0)
-						{
-							if (i % 2 == 0 && i < NumY - 2)
-							{
-								
-								Triangles.Add(idx);
-								Triangles.Add(idx + 2 * NumX);
-								Triangles.Add(idx + NumX + 1);
-
-								if (i > 0)
-								{
-									Triangles.Add(idx + 1);
-									Triangles.Add(idx);
-									Triangles.Add(idx + NumX + 1);
-								}
-
-								if (i + 2 < NumY - 2)
-								{
-									Triangles.Add(idx + 1 + NumX);
-									Triangles.Add(idx + 2*NumX);
-									Triangles.Add(idx + 2*NumX + 1);
-								}
-								
-
-							}
-
-						}
-						else
-						{
-							
-							if (i > 0 && i<NumY - 2)
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1);
-
-								Triangles.Add(idx + 1);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + NumX + 1);
-							}
-							else
-							{
-								if(i==0 && StitchY0)
-								{
-									Triangles.Add(idx);
-									Triangles.Add(idx + NumX);
-									Triangles.Add(idx + NumX + 1);
-								}
-								else
-								{
-									Triangles.Add(idx);
-									Triangles.Add(idx + NumX);
-									Triangles.Add(idx + 1);
-
-									Triangles.Add(idx + 1);
-									Triangles.Add(idx + NumX);
-									Triangles.Add(idx + NumX + 1);
-								}
-
-								
-							}
-							
-						}
-						
-					}
-					if (j == NumX - 2)
-					{
-
-						if (StitchXN)
-						{
-							if (i % 2 == 0 && i < NumY - 2)
-							{
-
-								Triangles.Add(idx+1);								
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1 + 2 * NumX);
-
-								if (i > 0)
-								{
-									Triangles.Add(idx + 1);
-									Triangles.Add(idx);
-									Triangles.Add(idx + NumX);
-								}
-
-								if (i + 2 < NumY - 2)
-								{
-									Triangles.Add(idx + NumX);
-									Triangles.Add(idx + 2 * NumX);
-									Triangles.Add(idx + 2 * NumX + 1);
-								}
-
-
-							}
-
-						}
-						else
-						{
-							
-							if(i>0 && i<NumY - 2)
-							{
-								Triangles.Add(idx);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + 1);
-
-								Triangles.Add(idx + 1);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + NumX + 1);
-							}
-							else if(i<NumY - 2)
-							{
-								Triangles.Add(idx + 1);
-								Triangles.Add(idx + NumX);
-								Triangles.Add(idx + NumX + 1);
-							}
-							else
-							{
-
-							
-							}
-							
-
-							
-						}
-						
-						
-						
-						
-					}
-
-
-				}
-
-
-			}
-		}
-	}
-}
-
 void AGeometryClipMapWorld::UpdateCameraLocation()
 {
 	int GUseStreamingManagerForCameras = 0;
@@ -574,25 +329,32 @@ void AGeometryClipMapWorld::UpdateCameraLocation()
 
 float AGeometryClipMapWorld::HeightToClosestCollisionMesh()
 {
-	UProceduralMeshComponent* ClosestMesh = nullptr;
+	FCollisionMeshElement* ClosestMesh = nullptr;
 	float ClosestDistance = -1.f;
 
 	for(int& i : UsedCollisionMesh)
 	{
-		FVector CompToCam = CollisionMesh[i].Mesh->GetComponentLocation()-CamLocation;
+		// Coarser tiles are further away
+		if (CollisionMesh[i].LOD != 0)
+			continue;
+
+		FVector CompToCam = CollisionMesh[i].GetComponent()->GetComponentLocation()-CamLocation;
 		CompToCam.Z=0.f;
 
 		if(ClosestDistance<0.f || CompToCam.Size()<ClosestDistance)
 		{
 			ClosestDistance=CompToCam.Size();
-			ClosestMesh = CollisionMesh[i].Mesh;
+			ClosestMesh = &CollisionMesh[i];
 		}
 
 	}
 
 	if(ClosestMesh)
 	{
-		FProcMeshSection* Section = ClosestMesh->GetProcMeshSection(0);
+		if (ClosestMesh->Heightfield)
+			return (ClosestMesh->Heightfield->GetLocalBox().GetCenter()-CamLocation).Z;
+
+		FProcMeshSection* Section = ClosestMesh->Mesh->GetProcMeshSection(0);
 
 		return (Section->SectionLocalBox.GetCenter()-CamLocation).Z;
 	}
@@ -709,8 +471,9 @@ void AGeometryClipMapWorld::UpdateClipMap()
 
 					if(Elem.Mesh)
 					{
-						Elem.Mesh->SetWorldLocation(LocRef + ToLoc, false, nullptr, ETeleportType::TeleportPhysics);
-						Elem.Mesh->MarkRenderTransformDirty();
+						// Only the level moves, the component keeps its transform
+						const FVector LevelOffset = Elem.Mesh->GetComponentTransform().InverseTransformPosition(LocRef + ToLoc);
+						Elem.Mesh->SetLevelTransform(Elem.MeshLevel, LevelOffset, FVector(Elem.GridSpacing, Elem.GridSpacing, 1.f));
 					}
 					if(Elem.I_Mesh)
 					{
@@ -795,6 +558,13 @@ void AGeometryClipMapWorld::UpdateClipMap()
 							}
 
 						}
+
+						if (CacheHeightBounds)
+						{
+							// Bounds of the terrain the level moved onto stay loose until its new HeightMap is read back
+							UpdateLevelHeightBounds(Elem);
+							RequestHeightBounds(Elem);
+						}
 					}
 					
 
@@ -805,7 +575,7 @@ void AGeometryClipMapWorld::UpdateClipMap()
 					{
 						UMaterialInstanceDynamic* MatDyn_ = nullptr;
 						if(Elem.Mesh)
-							MatDyn_ = Cast<UMaterialInstanceDynamic>(Elem.Mesh->GetMaterial(0));
+							MatDyn_ = Cast<UMaterialInstanceDynamic>(Elem.Mesh->GetMaterial(Elem.FirstSection));
 						if (Elem.I_Mesh)
 							MatDyn_ = Cast<UMaterialInstanceDynamic>(Elem.I_Mesh->GetMaterial(0));
 
@@ -838,71 +608,84 @@ void AGeometryClipMapWorld::UpdateClipMap()
 
 void AGeometryClipMapWorld::UpdateCollisionMesh()
 {
+		// Tiles are keyed by their X and Y in tiles of their LOD, and their LOD in Z
+		const int NumLODs = FMath::Clamp(CollisionLODs, 1, 8);
+		const int Quadrant = CollisionMeshPerQuadrantAroundPlayer;
 
+		auto CamTile = [&](int LOD)
+		{
+			FVector CompLoc = CamLocation / GetCollisionTileDimension(LOD);
+			return FIntPoint(FMath::FloorToInt(CompLoc.X), FMath::FloorToInt(CompLoc.Y));
+		};
 
+		// Ring of the coarsest LOD around the camera, tiles overlapping the ring of the next finer LOD are split in their 4 children
+		TArray<FIntVector> Tiles;
+		TArray<FIntVector> ToSplit;
 
-		FVector CompLoc = CamLocation / (CollisionMeshWorldDimension);
-		int CamX = FMath::Floor(CompLoc.X);
-		int CamY = FMath::Floor(CompLoc.Y);
-
-
-		FVector LocRef = CollisionMeshWorldDimension * FVector(CamX, CamY, 0.f) + GetActorLocation().Z * FVector(0.f, 0.f, 1);
+		const FIntPoint TopCam = CamTile(NumLODs - 1);
+		for(int i =-Quadrant; i<=Quadrant; i++)
+		{
+			for (int j = -Quadrant; j <= Quadrant; j++)
+			{
+				ToSplit.Add(FIntVector(TopCam.X+i,TopCam.Y+j,NumLODs - 1));
+			}
+		}
 
-		for(int i = UsedCollisionMesh.Num()-1 ;i>=0 ; i--)
+		while (ToSplit.Num() > 0)
 		{
-			FCollisionMeshElement& El = CollisionMesh[UsedCollisionMesh[i]];
-			FVector ToComp = (El.Mesh->GetComponentLocation()-LocRef)/CollisionMeshWorldDimension;
-			if(FMath::Abs(ToComp.X)>CollisionMeshPerQuadrantAroundPlayer || FMath::Abs(ToComp.Y)>CollisionMeshPerQuadrantAroundPlayer)
+			const FIntVector Tile = ToSplit.Pop(false);
+
+			if (Tile.Z > 0)
 			{
-				
-				
-				AvailableCollisionMesh.Add(El.ID);
-				UsedCollisionMesh.RemoveAt(i);
-				
-				
-				for (auto It = GroundCollisionLayout.CreateConstIterator(); It; ++It)
+				const FIntPoint FinerCam = CamTile(Tile.Z - 1);
+				const bool OverlapX = 2 * Tile.X + 1 >= FinerCam.X - Quadrant && 2 * Tile.X <= FinerCam.X + Quadrant;
+				const bool OverlapY = 2 * Tile.Y + 1 >= FinerCam.Y - Quadrant && 2 * Tile.Y <= FinerCam.Y + Quadrant;
+
+				if (OverlapX && OverlapY)
 				{
-					if (It->Value.Mesh == El.Mesh)
+					for (int Child = 0; Child < 4; Child++)
 					{
-						GroundCollisionLayout.Remove(It->Key);
-						break;
+						ToSplit.Add(FIntVector(2 * Tile.X + (Child & 1), 2 * Tile.Y + (Child >> 1), Tile.Z - 1));
 					}
+					continue;
 				}
-				
 			}
-				
+
+			Tiles.Add(Tile);
 		}
 
-		
+		// Finest tiles first, they are the ones the player stands on when read backs are queued
+		Tiles.Sort([](const FIntVector& A, const FIntVector& B) { return A.Z < B.Z; });
+
+		TSet<FIntVector> TileSet;
+		TileSet.Append(Tiles);
 
-		for(int i =-CollisionMeshPerQuadrantAroundPlayer; i<=CollisionMeshPerQuadrantAroundPlayer; i++)
+		for (auto It = GroundCollisionLayout.CreateIterator(); It; ++It)
 		{
-			for (int j = -CollisionMeshPerQuadrantAroundPlayer; j <= CollisionMeshPerQuadrantAroundPlayer; j++)
+			if (!TileSet.Contains(It->Key))
 			{
-				FIntVector LocMeshInt = FIntVector(CamX+i,CamY+j,0);
-
-				FVector MeshLoc = CollisionMeshWorldDimension*FVector(LocMeshInt) + GetActorLocation().Z * FVector(0.f, 0.f, 1);
-				
-
-				if(!GroundCollisionLayout.Contains(LocMeshInt))
-				{
-					FCollisionMeshElement& Mesh = GetACollisionMesh();
+				AvailableCollisionMesh.Add(It->Value.ID);
+				UsedCollisionMesh.Remove(It->Value.ID);
+				It.RemoveCurrent();
+			}
+		}
 
-					Mesh.Location=MeshLoc;
-					Mesh.Mesh->SetWorldLocation(MeshLoc, false, nullptr, ETeleportType::TeleportPhysics);
+		for (const FIntVector& Tile : Tiles)
+		{
+			if(!GroundCollisionLayout.Contains(Tile))
+			{
+				FVector MeshLoc = GetCollisionTileDimension(Tile.Z)*FVector(Tile.X, Tile.Y, 0.f) + GetActorLocation().Z * FVector(0.f, 0.f, 1);
 
-					UpdateCollisionMeshData(Mesh);					
-				
-					GroundCollisionLayout.Add(LocMeshInt,Mesh);
+				FCollisionMeshElement& Mesh = GetACollisionMesh(Tile.Z);
 
-				}
+				Mesh.Location=MeshLoc;
+				Mesh.GetComponent()->SetWorldLocation(MeshLoc, false, nullptr, ETeleportType::TeleportPhysics);
 
+				UpdateCollisionMeshData(Mesh);					
+			
+				GroundCollisionLayout.Add(Tile,Mesh);
 			}
-		
 		}
-
-		
-
 }
 
 
@@ -934,6 +717,21 @@ void AGeometryClipMapWorld::ProcessCollisionsPending()
 	
 		FCollisionMeshElement& Mesh = CollisionMesh[ElID];
 
+		if (Mesh.Heightfield)
+		{
+			// Heights go to the heightfield as they are, nothing to triangulate or cook
+			TArray<float> Heights;
+			Heights.SetNumUninitialized(Mesh.HeightData.Num());
+
+			ParallelFor(Heights.Num(), [&](int32 k)
+			{
+				Heights[k] = GetHeightFromGPURead(Mesh.HeightData[k]);
+			});
+
+			Mesh.Heightfield->SetHeights(MoveTemp(Heights));
+			continue;
+		}
+
 		FVector MesgLoc = Mesh.Mesh->GetComponentLocation();
 		//SetProcMeshSection
 		FProcMeshSection* Section = Mesh.Mesh->GetProcMeshSection(0);
@@ -990,35 +788,366 @@ void AGeometryClipMapWorld::ProcessCollisionsPending()
 
 }
 
-double AGeometryClipMapWorld::ComputeWorldHeightAt(FVector WorldLocation)
+/** Render thread, copy the rows of a completed readback to a tightly packed Resolution x Resolution array, false while the GPU is not done */
+static bool CopyCompletedReadback(FRHIGPUTextureReadback& Readback, int32 Resolution, TArray<FColor>& OutTexels)
 {
-	//Implement your noise here // same one as the one in shader
-
-
+	if (!Readback.IsReady())
+		return false;
 
-	return 0.f;
+	OutTexels.SetNumUninitialized(Resolution * Resolution, false);
 
+	int32 RowPitchInPixels = 0;
+	const FColor* Data = static_cast<const FColor*>(Readback.Lock(RowPitchInPixels));
+	if (Data)
+	{
+		for (int32 Y = 0; Y < Resolution; Y++)
+		{
+			FMemory::Memcpy(OutTexels.GetData() + Y * Resolution, Data + Y * RowPitchInPixels, Resolution * sizeof(FColor));
+		}
+	}
+	else
+	{
+		OutTexels.Reset();
+	}
+	Readback.Unlock();
 
+	return true;
 }
 
-void ReadPixelsFromRT(UTextureRenderTarget2D* InRT, FCollisionMeshElement& Mesh)
+bool AGeometryClipMapWorld::CanReadHeightBounds(const UTextureRenderTarget2D* HeightMap)
 {
-	ENQUEUE_RENDER_COMMAND(ReadGeoClipMapRTCmd)(
-		[InRT, &Mesh](FRHICommandListImmediate& RHICmdList)
-	{		
-		check(IsInRenderingThread());
+	if (!HeightMap || !CacheMatPacksHeight)
+		return false;
 
-			Mesh.HeightData.SetNum(InRT->GetRenderTargetResource()->GetSizeX()*InRT->GetRenderTargetResource()->GetSizeX(),false);
-			RHICmdList.ReadSurfaceData(
-				InRT->GetRenderTargetResource()->GetRenderTargetTexture(),
-				FIntRect(0, 0, InRT->GetRenderTargetResource()->GetSizeX(), InRT->GetRenderTargetResource()->GetSizeY()),
-				Mesh.HeightData,
-				FReadSurfaceDataFlags());
-			
-		
-		
-	});
-	FlushRenderingCommands();
+	// Read back as FColor, a float or sRGB target would not hold the packed bytes
+	if (HeightMap->RenderTargetFormat != RTF_RGBA8)
+	{
+		UE_CLOG(!HeightMapFormatWarned, LogTemp, Warning, TEXT("%s: HeightMap is not RGBA8, the rings are bounded with VerticalRangeMeters"), *GetName());
+		HeightMapFormatWarned = true;
+		return false;
+	}
+
+	return true;
+}
+
+bool AGeometryClipMapWorld::RequestHeightBounds(FClipMapMeshElement& Elem)
+{
+	Elem.bHeightReadPending = false;
+
+	if (!CanReadHeightBounds(Elem.HeightMap))
+	{
+		// Whatever was read before no longer matches the HeightMap
+		Elem.HeightPyramid.Reset();
+		return true;
+	}
+
+	FTextureRenderTargetResource* RTResource = Elem.HeightMap->GameThread_GetRenderTargetResource();
+	if (!RTResource)
+	{
+		Elem.bHeightReadPending = true;
+		return false;
+	}
+
+	if (!Elem.HeightRead.IsValid())
+		Elem.HeightRead = MakeShared<FClipMapHeightRead, ESPMode::ThreadSafe>();
+
+	// A read still in flight is for a previous location, the new serial supersedes it
+	TSharedPtr<FClipMapHeightRead, ESPMode::ThreadSafe> HeightRead = Elem.HeightRead;
+	HeightRead->bInFlight = true;
+	HeightRead->Serial++;
+	HeightRead->Resolution = Elem.HeightMap->SizeX;
+	HeightRead->Location = Elem.Location;
+
+	const int32 Serial = HeightRead->Serial;
+
+	// Copied to a staging texture, ProcessHeightBoundsPending maps it once the GPU is done
+	ENQUEUE_RENDER_COMMAND(ReadGeoClipMapHeightBoundsCmd)(
+		[RTResource, HeightRead, Serial](FRHICommandListImmediate& RHICmdList)
+	{
+		if (!HeightRead->Readback.IsValid())
+			HeightRead->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("GeoClipMapHeightBoundsRead"));
+
+		HeightRead->Readback->EnqueueCopy(RHICmdList, RTResource->GetRenderTargetTexture());
+		HeightRead->EnqueuedSerial = Serial;
+	});
+
+	return true;
+}
+
+void AGeometryClipMapWorld::ProcessHeightBoundsPending()
+{
+	TArray<TSharedPtr<FClipMapHeightRead, ESPMode::ThreadSafe>> Waiting;
+
+	for (FClipMapMeshElement& Elem : Meshes)
+	{
+		if (Elem.bHeightReadPending)
+			RequestHeightBounds(Elem);
+
+		if (!Elem.HeightRead.IsValid() || !Elem.HeightRead->bInFlight)
+			continue;
+
+		FClipMapHeightRead& HeightRead = *Elem.HeightRead;
+		if (HeightRead.CopiedSerial.GetValue() != HeightRead.Serial)
+		{
+			Waiting.Add(Elem.HeightRead);
+			continue;
+		}
+
+		HeightRead.bInFlight = false;
+
+		const int32 Res = HeightRead.Resolution;
+		if (Res <= 1 || HeightRead.Texels.Num() != Res * Res || !CanReadHeightBounds(Elem.HeightMap))
+			continue;
+
+		TArray<float> Heights;
+		Heights.SetNumUninitialized(Res * Res);
+
+		ParallelFor(Res, [&](int32 Y)
+		{
+			for (int32 X = 0; X < Res; X++)
+			{
+				Heights[Y * Res + X] = GetHeightFromGPURead(HeightRead.Texels[Y * Res + X]);
+			}
+		});
+
+		Elem.HeightPyramid.Build(Heights, Res);
+		Elem.HeightPyramidLocation = HeightRead.Location;
+
+		UpdateLevelHeightBounds(Elem);
+	}
+
+	if (Waiting.Num() > 0)
+	{
+		ENQUEUE_RENDER_COMMAND(PollGeoClipMapHeightBoundsCmd)(
+			[Waiting](FRHICommandListImmediate& RHICmdList)
+		{
+			for (const TSharedPtr<FClipMapHeightRead, ESPMode::ThreadSafe>& HeightRead : Waiting)
+			{
+				// Already copied by an earlier poll, or the copy is not enqueued yet
+				if (!HeightRead->Readback.IsValid() || HeightRead->CopiedSerial.GetValue() == HeightRead->EnqueuedSerial)
+					continue;
+
+				if (CopyCompletedReadback(*HeightRead->Readback, HeightRead->Resolution, HeightRead->Texels))
+					HeightRead->CopiedSerial.Set(HeightRead->EnqueuedSerial);
+			}
+		});
+	}
+}
+
+void AGeometryClipMapWorld::UpdateLevelHeightBounds(FClipMapMeshElement& Elem)
+{
+	if (!Elem.Mesh || !RingGeometry.IsValid())
+		return;
+
+	// Heights are relative to the component, like the collision meshes
+	const float FallbackRange = VerticalRangeMeters * 100.f;
+	const float HalfExtent = (N - 1) * 0.5f;
+
+	const int32 Res = Elem.HeightPyramid.GetResolution();
+	const float TexelsPerUnit = Res > 1 ? (Res - 1) / float(N - 1) : 0.f;
+	// The level may have moved since its HeightMap was read back
+	const FVector2D TexelShift = FVector2D(Elem.Location - Elem.HeightPyramidLocation) * (TexelsPerUnit / Elem.GridSpacing);
+
+	FBox SectionBoxes[GeoClipmapRingSection::Num];
+	TArray<FBox> BlockBoxes[GeoClipmapRingSection::Num];
+
+	for (int SectionID = 0; SectionID < GeoClipmapRingSection::Num; SectionID++)
+	{
+		const TArray<FGeoClipmapIndexRange>& Blocks = RingGeometry->GetSectionBlocks(SectionID);
+
+		FBox& SectionBox = SectionBoxes[SectionID];
+		SectionBox.Init();
+		BlockBoxes[SectionID].Reserve(Blocks.Num());
+
+		for (const FGeoClipmapIndexRange& Block : Blocks)
+		{
+			FBox Box = Block.LocalBox;
+
+			float MinHeight = -FallbackRange;
+			float MaxHeight = FallbackRange;
+
+			if (Elem.HeightPyramid.IsValid())
+			{
+				const FIntPoint MinTexel(FMath::FloorToInt((Box.Min.X + HalfExtent) * TexelsPerUnit + TexelShift.X), FMath::FloorToInt((Box.Min.Y + HalfExtent) * TexelsPerUnit + TexelShift.Y));
+				const FIntPoint MaxTexel(FMath::CeilToInt((Box.Max.X + HalfExtent) * TexelsPerUnit + TexelShift.X), FMath::CeilToInt((Box.Max.Y + HalfExtent) * TexelsPerUnit + TexelShift.Y));
+
+				// Terrain outside of the read back HeightMap keeps the loose range
+				if (MinTexel.X >= 0 && MinTexel.Y >= 0 && MaxTexel.X < Res && MaxTexel.Y < Res)
+					Elem.HeightPyramid.GetHeightRange(MinTexel, MaxTexel, MinHeight, MaxHeight);
+			}
+
+			Box.Min.Z += MinHeight;
+			Box.Max.Z += MaxHeight;
+
+			BlockBoxes[SectionID].Add(Box);
+			SectionBox += Box;
+		}
+
+		if (!SectionBox.IsValid)
+		{
+			SectionBox = RingGeometry->GetSectionRange(SectionID).LocalBox;
+			SectionBox.Min.Z -= FallbackRange;
+			SectionBox.Max.Z += FallbackRange;
+		}
+	}
+
+	// All the sections at once, the mesh bounds are updated a single time
+	Elem.Mesh->UpdateCustomBounds(Elem.FirstSection, MakeArrayView(SectionBoxes), MakeArrayView(BlockBoxes));
+}
+
+double AGeometryClipMapWorld::ComputeWorldHeightAt(FVector WorldLocation)
+{
+	double Height = 0.0;
+	const double X = WorldLocation.X;
+	const double Y = WorldLocation.Y;
+	ComputeWorldHeightsAt(MakeArrayView(&X, 1), MakeArrayView(&Y, 1), MakeArrayView(&Height, 1));
+
+	return Height;
+}
+
+void AGeometryClipMapWorld::ComputeWorldHeightsAt(TArrayView<const double> X, TArrayView<const double> Y, TArrayView<double> OutHeights)
+{
+	check(Y.Num() == X.Num() && OutHeights.Num() == X.Num());
+
+	const double ActorHeight = GetActorLocation().Z;
+	for (double& Height : OutHeights)
+	{
+		Height = ActorHeight;
+	}
+
+	TArray<float> Values;
+	Values.SetNumUninitialized(X.Num());
+
+	if (CPUHeightProgram.IsValid())
+	{
+		CPUHeightProgram.EvaluateBatch(X, Y, ActorHeight, Values);
+
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			OutHeights[Index] += Values[Index];
+		}
+		return;
+	}
+
+	for (const FGeoClipmapNoiseLayer& Layer : CPUHeightLayers)
+	{
+		FGeoClipmapNoise::EvaluateBatch(Layer, X, Y, ActorHeight, Values);
+
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			OutHeights[Index] += (Values[Index] - Layer.GlobalOffset) * Layer.Scale;
+		}
+	}
+}
+
+bool AGeometryClipMapWorld::RequestCollisionRead(FCollisionMeshElement& Mesh)
+{
+	TSharedPtr<FCollisionHeightRead, ESPMode::ThreadSafe> Read;
+	int32 NumInFlight = 0;
+
+	for (const TSharedPtr<FCollisionHeightRead, ESPMode::ThreadSafe>& Slot : CollisionReadbacks)
+	{
+		if (Slot->bInFlight)
+			NumInFlight++;
+		else if (!Read.IsValid())
+			Read = Slot;
+	}
+
+	if (NumInFlight >= FMath::Clamp(CollisionReadbacksInFlight, 1, 64))
+		return false;
+
+	// Kept queued, the tile is read once its render target has a resource
+	FTextureRenderTargetResource* RTResource = Mesh.CollisionRT->GameThread_GetRenderTargetResource();
+	if (!RTResource)
+		return false;
+
+	if (!Read.IsValid())
+		Read = CollisionReadbacks.Add_GetRef(MakeShared<FCollisionHeightRead, ESPMode::ThreadSafe>());
+
+	UMaterialInstanceDynamic* DynCollisionMat = UMaterialInstanceDynamic::Create(CollisionMat_HeightRead, this);
+	DynCollisionMat->SetVectorParameterValue("MeshLocation",Mesh.GetComponent()->GetComponentLocation());
+	DynCollisionMat->SetScalarParameterValue("MeshScale",GetCollisionTileDimension(Mesh.LOD)*CollisionMeshVerticeNumber/(CollisionMeshVerticeNumber-1));
+	UKismetRenderingLibrary::ClearRenderTarget2D(this, Mesh.CollisionRT, FLinearColor::Black);
+
+	UKismetRenderingLibrary::DrawMaterialToRenderTarget(this, Mesh.CollisionRT, DynCollisionMat);
+
+	Read->bInFlight = true;
+	Read->Serial++;
+	Read->MeshID = Mesh.ID;
+	Read->Location = Mesh.Location;
+	Read->Resolution = Mesh.CollisionRT->SizeX;
+
+	const int32 Serial = Read->Serial;
+
+	// Copied to a staging texture after the draw, PollCollisionReads maps it once the GPU is done
+	ENQUEUE_RENDER_COMMAND(ReadGeoClipMapCollisionCmd)(
+		[RTResource, Read, Serial](FRHICommandListImmediate& RHICmdList)
+	{
+		if (!Read->Readback.IsValid())
+			Read->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("GeoClipMapCollisionRead"));
+
+		Read->Readback->EnqueueCopy(RHICmdList, RTResource->GetRenderTargetTexture());
+		Read->EnqueuedSerial = Serial;
+	});
+
+	return true;
+}
+
+void AGeometryClipMapWorld::PollCollisionReads()
+{
+	TArray<TSharedPtr<FCollisionHeightRead, ESPMode::ThreadSafe>> Waiting;
+
+	for (const TSharedPtr<FCollisionHeightRead, ESPMode::ThreadSafe>& Read : CollisionReadbacks)
+	{
+		if (!Read->bInFlight)
+			continue;
+
+		if (Read->CopiedSerial.GetValue() != Read->Serial)
+		{
+			Waiting.Add(Read);
+			continue;
+		}
+
+		Read->bInFlight = false;
+
+		// The mesh was released or moved since it was drawn, a newer read of it may be in flight
+		if (!UsedCollisionMesh.Contains(Read->MeshID) || CollisionMesh[Read->MeshID].Location != Read->Location)
+			continue;
+
+		if (Read->Texels.Num() != Read->Resolution * Read->Resolution)
+			continue;
+
+		FCollisionMeshElement& Mesh = CollisionMesh[Read->MeshID];
+		Swap(Mesh.HeightData, Read->Texels);
+		CollisionReadToProcess.AddUnique(Mesh.ID);
+	}
+
+	if (Waiting.Num() > 0)
+	{
+		ENQUEUE_RENDER_COMMAND(PollGeoClipMapCollisionCmd)(
+			[Waiting](FRHICommandListImmediate& RHICmdList)
+		{
+			for (const TSharedPtr<FCollisionHeightRead, ESPMode::ThreadSafe>& Read : Waiting)
+			{
+				// Already copied by an earlier poll, or the copy is not enqueued yet
+				if (!Read->Readback.IsValid() || Read->CopiedSerial.GetValue() == Read->EnqueuedSerial)
+					continue;
+
+				if (CopyCompletedReadback(*Read->Readback, Read->Resolution, Read->Texels))
+					Read->CopiedSerial.Set(Read->EnqueuedSerial);
+			}
+		});
+	}
+
+	// Tiles beyond CollisionReadbacksInFlight get the slots freed above
+	int32 NumIssued = 0;
+	for (; NumIssued < CollisionReadQueued.Num(); NumIssued++)
+	{
+		const int MeshID = CollisionReadQueued[NumIssued];
+		if (UsedCollisionMesh.Contains(MeshID) && !RequestCollisionRead(CollisionMesh[MeshID]))
+			break;
+	}
+	CollisionReadQueued.RemoveAt(0, NumIssued);
 }
 
 void AGeometryClipMapWorld::UpdateCollisionMeshData(FCollisionMeshElement& Mesh)
@@ -1026,42 +1155,74 @@ void AGeometryClipMapWorld::UpdateCollisionMeshData(FCollisionMeshElement& Mesh)
 	// Couple options i see here, either make a readback from a render target applying the same noise than the geoclipmap mesh
 	// or implement the same noise in C++ and compute it in parallel/on another thread
 
-	FVector MesgLoc = Mesh.Mesh->GetComponentLocation();
+	FVector MesgLoc = Mesh.GetComponent()->GetComponentLocation();
 
 	
-	if (CollisionMat_HeightRead)
+	if (CollisionMat_HeightRead && !HasCPUHeight())
 	{
-		//OPTION A : Compute collision form GPU readback
+		//OPTION A : Compute collision form GPU readback, handed to ProcessCollisionsPending a few frames later by PollCollisionReads
+
+		if (!RequestCollisionRead(Mesh))
+			CollisionReadQueued.AddUnique(Mesh.ID);
+		
+		return;
+	}
+	
+	if (!HasCPUHeight())
+		return;
+
+	//OPTION B : Same noise as the one in Shader graph, evaluated here in a single batch to generate the collision mesh
 
-		UMaterialInstanceDynamic* DynCollisionMat = UMaterialInstanceDynamic::Create(CollisionMat_HeightRead, this);
-		DynCollisionMat->SetVectorParameterValue("MeshLocation",MesgLoc);
-		DynCollisionMat->SetScalarParameterValue("MeshScale",CollisionMeshWorldDimension*CollisionMeshVerticeNumber/(CollisionMeshVerticeNumber-1));
-		UKismetRenderingLibrary::ClearRenderTarget2D(this, Mesh.CollisionRT, FLinearColor::Black);
-		//Mesh.CollisionRT->UpdateResourceImmediate();
+	if (Mesh.Heightfield)
+	{
+		const int NumV = Mesh.Heightfield->GetNumVertices();
+		const float Spacing = Mesh.Heightfield->GetSpacing();
 
-		UKismetRenderingLibrary::DrawMaterialToRenderTarget(this, Mesh.CollisionRT, DynCollisionMat);
+		TArray<double> VerticesX;
+		VerticesX.SetNumUninitialized(NumV * NumV);
+		TArray<double> VerticesY;
+		VerticesY.SetNumUninitialized(NumV * NumV);
+		TArray<double> Heights;
+		Heights.SetNumUninitialized(NumV * NumV);
 
-		Mesh.HeightData.Empty();
-		Mesh.HeightData.SetNum(CollisionMeshVerticeNumber*CollisionMeshVerticeNumber,false);
+		for (int k = 0; k < NumV * NumV; k++)
+		{
+			VerticesX[k] = (k % NumV) * Spacing + MesgLoc.X;
+			VerticesY[k] = (k / NumV) * Spacing + MesgLoc.Y;
+		}
 
+		ComputeWorldHeightsAt(VerticesX, VerticesY, Heights);
 
-		ReadPixelsFromRT(Mesh.CollisionRT,Mesh);
+		TArray<float> LocalHeights;
+		LocalHeights.SetNumUninitialized(Heights.Num());
+		for (int k = 0; k < Heights.Num(); k++)
+		{
+			LocalHeights[k] = Heights[k] - MesgLoc.Z;
+		}
 
-		CollisionReadToProcess.Add(Mesh.ID);
-		
+		Mesh.Heightfield->SetHeights(MoveTemp(LocalHeights));
 		return;
 	}
-	
-	return;
-
-	//OPTION B : Implement in c++ the same noise as the one in Shader graph and evaluate the noise here to generate the collision mesh
-	
-	
 
 	FProcMeshSection* Section = Mesh.Mesh->GetProcMeshSection(0);
 
 	int NumOfVertex = Section->ProcVertexBuffer.Num();
 
+	TArray<double> VerticesX;
+	VerticesX.SetNumUninitialized(NumOfVertex);
+	TArray<double> VerticesY;
+	VerticesY.SetNumUninitialized(NumOfVertex);
+	TArray<double> Heights;
+	Heights.SetNumUninitialized(NumOfVertex);
+
+	for (int k = 0; k < NumOfVertex; k++)
+	{
+		VerticesX[k] = Section->ProcVertexBuffer[k].Position.X + MesgLoc.X;
+		VerticesY[k] = Section->ProcVertexBuffer[k].Position.Y + MesgLoc.Y;
+	}
+
+	ComputeWorldHeightsAt(VerticesX, VerticesY, Heights);
+
 	TArray<FVector> Vertices;
 	Vertices.SetNum(NumOfVertex);
 	TArray<FVector> Normals;
@@ -1074,13 +1235,9 @@ void AGeometryClipMapWorld::UpdateCollisionMeshData(FCollisionMeshElement& Mesh)
 	
 	ParallelFor(NumOfVertex, [&](int32 k)
 	{
-		FVector LocationfVertice_WS = Section->ProcVertexBuffer[k].Position*FVector(1.f,1.f,0.f) + MesgLoc;
-
-		// ComputeWorldHeightAt is empty / not Implemented
+		FVector LocationfVertice_WS = FVector(VerticesX[k], VerticesY[k], Heights[k]);
 
-		LocationfVertice_WS.Z = ComputeWorldHeightAt(LocationfVertice_WS);
-
-		Vertices[k] = LocationfVertice_WS - Mesh.Mesh->GetComponentLocation();
+		Vertices[k] = LocationfVertice_WS - MesgLoc;
 		Normals[k] = FVector(0.f,0.f,1.f);
 		UV[k] = FVector2D(0.f,0.f);
 		Colors[k] = FColor::Blue;
@@ -1092,6 +1249,9 @@ void AGeometryClipMapWorld::UpdateCollisionMeshData(FCollisionMeshElement& Mesh)
 
 	Mesh.Mesh->UpdateMeshSection(0,Vertices,Normals,UV,Colors,Tangents);
 
+	if(HasActorBegunPlay())
+		Mesh.Mesh->ClearCollisionConvexMeshes();
+
 }
 
 FTransform AGeometryClipMapWorld::GetWorldTransformOfSpawnable(const FVector& CompLoc, FColor& LocX,FColor& LocY,FColor& LocZ,FColor& Rot)
@@ -1234,18 +1394,29 @@ void AGeometryClipMapWorld::UpdateParentInnerMesh(int ChildLevel,EClipMapInterio
 	}
 }
 
-FCollisionMeshElement& AGeometryClipMapWorld::GetACollisionMesh()
+USceneComponent* FCollisionMeshElement::GetComponent() const
+{
+	if (Heightfield)
+		return Heightfield;
+	return Mesh;
+}
+
+FCollisionMeshElement& AGeometryClipMapWorld::GetACollisionMesh(int LOD)
 {
-	if(AvailableCollisionMesh.Num()>0)
+	for(int i = AvailableCollisionMesh.Num()-1; i>=0; i--)
 	{
-		FCollisionMeshElement& Elem = CollisionMesh[AvailableCollisionMesh[AvailableCollisionMesh.Num()-1]];
+		FCollisionMeshElement& Elem = CollisionMesh[AvailableCollisionMesh[i]];
+		if (Elem.LOD != LOD)
+			continue;
+
 		UsedCollisionMesh.Add(Elem.ID);
-		AvailableCollisionMesh.RemoveAt(AvailableCollisionMesh.Num()-1);
+		AvailableCollisionMesh.RemoveAt(i);
 		return Elem;
 	}
 
 	FCollisionMeshElement NewElem;
 	NewElem.ID=CollisionMesh.Num();
+	NewElem.LOD=LOD;
 
 	UWorld* World = GetWorld();
 
@@ -1258,7 +1429,21 @@ FCollisionMeshElement& AGeometryClipMapWorld::GetACollisionMesh()
 	
 	NewElem.CollisionRT->UpdateResourceImmediate();
 
+	float Spacing = GetCollisionTileDimension(LOD)/(CollisionMeshVerticeNumber-1);
+
+	if (HeightfieldCollision)
+	{
+		NewElem.Heightfield = NewObject<UGeoClipmapHeightfieldComponent>(this, NAME_None, RF_Transient);
+		NewElem.Heightfield->SetupAttachment(RootComponent);
+		NewElem.Heightfield->SetGrid(CollisionMeshVerticeNumber, Spacing);
+		NewElem.Heightfield->RegisterComponent();
+		NewElem.Heightfield->SetRelativeLocation(FVector(0.f,0.f, 0.f));
+
+		UsedCollisionMesh.Add(NewElem.ID);
+		CollisionMesh.Add(NewElem);
 
+		return CollisionMesh[CollisionMesh.Num()-1];
+	}
 
 	NewElem.Mesh = NewObject<UProceduralMeshComponent>(this, NAME_None, RF_Transient);
 
@@ -1275,8 +1460,6 @@ FCollisionMeshElement& AGeometryClipMapWorld::GetACollisionMesh()
 	TArray<int32> Triangles;
 	TArray<FVector2D> UV;
 
-	float Spacing = CollisionMeshWorldDimension/(CollisionMeshVerticeNumber-1);
-
 	UKismetProceduralMeshLibrary::CreateGridMeshWelded(CollisionMeshVerticeNumber,CollisionMeshVerticeNumber,Triangles,Vertices,UV,Spacing);
 
 	TArray<FVector> Normals;
@@ -1315,16 +1498,57 @@ void AGeometryClipMapWorld::InitiateWorld()
 	if(Meshes.Num()>0)
 		return;
 
+	// Instanced meshes are not stitched, each instance being a vertex
+	const uint8 StichingProfile = WorldPresentation==EWorldPresentation::InstancedMesh ? 0 : 1<<3|1<<2|1<<1|1;
+	// Instances read their location from the full vertices
+	EGeoClipmapVertexFormat VertexFormat = EGeoClipmapVertexFormat::Full;
+	if(WorldPresentation==EWorldPresentation::Bufferless)
+		VertexFormat = EGeoClipmapVertexFormat::Bufferless;
+	else if(CompactVertices && WorldPresentation!=EWorldPresentation::InstancedMesh)
+		VertexFormat = EGeoClipmapVertexFormat::Compact;
+	// Read back heights bound the rings, the vertices no longer have to be displaced to grow the bounds
+	const float VerticalJitter = EnableCaching && CacheHeightBounds ? 0.f : VerticalRangeMeters*100.f;
+	const FGeoClipmapRingGeometryKey RingKey(N, StichingProfile, VerticalJitter, VertexFormat);
+
+	// Stage 1 : ring geometry is built on worker threads, the world is initiated on a later tick once it is ready
+	if(!RingGeometry.IsValid() || RingGeometry->GetKey()!=RingKey)
+	{
+		RingGeometry = FGeoClipmapRingGeometry::Find(RingKey);
+
+		if(!RingGeometry.IsValid())
+		{
+			if(PendingRingGeometry.IsValid() && PendingRingGeometry.IsReady())
+			{
+				TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> Built = PendingRingGeometry.Get();
+				PendingRingGeometry.Reset();
+
+				if(Built.IsValid() && Built->GetKey()==RingKey)
+					RingGeometry = Built;
+			}
+
+			if(!RingGeometry.IsValid())
+			{
+				if(!PendingRingGeometry.IsValid())
+				{
+					PendingRingGeometry = Async(EAsyncExecution::ThreadPool, [RingKey]()
+					{
+						return TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe>(FGeoClipmapRingGeometry::FindOrCreate(RingKey));
+					});
+				}
+				return;
+			}
+		}
+	}
+
+	// Stage 2 : game thread, components registration, MIDs and cache draws
+
 	for(int i=0; i<Level;i++)
 	{
-		int LOD = Level-1-i;
 		FClipMapMeshElement NewElem;	
 
 		NewElem.Level=i;
 		NewElem.GridSpacing=pow(2.0,-i)*GridSpacing;
 
-		int LocalM = (N+1)/4;
-
 		int CacheRes = (i< Level-LOD_above_doubleCacheResolution  /*Level/2*/?2.0f:1.0f)*ClipMapCacheIntraVerticesTexel*(N-1) +1;
 		//int CacheRes = ClipMapCacheIntraVerticesTexel*N;
 
@@ -1373,468 +1597,97 @@ void AGeometryClipMapWorld::InitiateWorld()
 			NewElem.I_Mesh->SetRelativeLocation(FVector(-NewElem.GridSpacing, -NewElem.GridSpacing, 0.f));
 			NewElem.I_Mesh->CastShadow=true;
 			NewElem.I_Mesh->bCastFarShadow=true;
-			
-		}
-		else
-		{
-			NewElem.Mesh = NewObject<UGeoClipmapMeshComponent>(this, NAME_None, RF_Transient);
-			NewElem.Mesh->SetupAttachment(RootComponent);
-			NewElem.Mesh->RegisterComponent();
-
-			NewElem.Mesh->bUseComplexAsSimpleCollision = true;
-			NewElem.Mesh->bNeverDistanceCull = true;
-
-			NewElem.Mesh->CastShadow = true;
-			NewElem.Mesh->bCastFarShadow = true;
-
-			NewElem.Mesh->SetRelativeLocation(FVector(-NewElem.GridSpacing, -NewElem.GridSpacing, 0.f));
-		}
-
-		
-
-
-		
-		
-
-		TArray<FVector> Vertices;
-		TArray<int32> Triangles;
-		TArray<FVector2D> UV;
-		TArray<FVector2D> UV1;
-		TArray<FVector2D> UV2;
-		TArray<FVector2D> UV_dummy;
-		TArray<FColor> Color_dummy;
-
-
-		float LocalExtent = ((N - 1) * NewElem.GridSpacing) / 2.f;
-		FVector LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f);	
-
-		// StichingProfile
-		// 1<<3 X=0
-		// 1<<2 X=N-1
-		// 1<<1 Y=0
-		// 1 Y=N-1
-		uint8 StichingProfile = 1<<3|1<<2|1<<1|1;
 
-		if(NewElem.I_Mesh)
-			StichingProfile = 0;
-
-		
-		CreateGridMeshWelded(LOD,N,N,Triangles,Vertices,UV,UV1,UV2,NewElem.GridSpacing,LocalOffset,StichingProfile);
-
-		if(NewElem.I_Mesh)
-		{
-			int NumI = Vertices.Num();
-			TArray<FTransform> InstanceT;
-			InstanceT.SetNum(NumI);
-			float ScaleLocal = pow(2.0,-i+Level-1);
-
-			ParallelFor(NumI, [&](int32 k)
+			// Instances are placed from the unit ring vertices scaled by this level GridSpacing
+			for (int SectionID = 0; SectionID < GeoClipmapRingSection::Num; SectionID++)
 			{
-				if (k < NumI)
-				{
-					FTransform& T = InstanceT[k];
-					T.SetLocation(Vertices[k]);		
-					T.SetRotation(FQuat::Identity);
-					T.SetScale3D(NewElem.GridSpacing/100.f* FVector(1.f,1.f,1.f));
-				}
-
-			});
+				// One instance per vertex of each grid patch of the section, the welded ring mesh shares them between sections
+				TArray<FGeoClipmapGridPatch> Patches;
+				FGeoClipmapRingGeometry::GetSectionGridPatches(RingKey, SectionID, Patches);
 
-			const TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
-
-			if(!(Indexes.Num()!=NumI || UV.Num()!=NumI|| UV1.Num()!=NumI))
-			
-				ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
-				{
-					TArray<float> CustomData;
-					//Section Indentifier
-					CustomData.Add(0.f);
-					CustomData.Add(UV[k].X);
-					CustomData.Add(UV[k].Y);
-					CustomData.Add(UV1[k].X);
-					CustomData.Add(UV1[k].Y);
-
-					NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
-				}
-
-			});
-			else
-			{
-				UE_LOG(LogTemp,Warning,TEXT("Indexes.Num %d UV num %d UV1 num %d"),Indexes.Num(),UV.Num(),UV1.Num());
-			}
-
-
-						
-		}
-
-		//stiching
-
-
-
-		
-		TArray<FVector> Normals;
-		Normals.Init(FVector(0.f, 0.f, 1.f), Vertices.Num());
-		TArray<FGeoCProcMeshTangent> Tangents;
-		Tangents.Init(FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false), Vertices.Num());
-
-		if(NewElem.Mesh)
-		NewElem.Mesh->CreateMeshSection(0,Vertices,Triangles,Normals,UV,UV1,UV2,UV_dummy,Color_dummy,Tangents,false);
-		
-
-
-		Vertices.Empty();
-		Triangles.Empty();
-		UV.Empty();
-		UV1.Empty();
-		UV2.Empty();
-		
-		StichingProfile = 1<<3|1<<2|1<<1;
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,N,3,Triangles,Vertices,UV,UV1,UV2,NewElem.GridSpacing,LocalOffset,StichingProfile);		
-
-		
-		StichingProfile = 0;
-		LocalOffset = FVector(-LocalExtent,-LocalExtent,0.f) + 2.f*NewElem.GridSpacing*FVector(0.f,1.f,0.f)  + (LocalM-1)*NewElem.GridSpacing*FVector(1.f,0.f,0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,(LocalM-1)*2+3,(LocalM-1)-2+1, Triangles, Vertices, UV, UV1,UV2, NewElem.GridSpacing, LocalOffset, StichingProfile);
-		LocalOffset = FVector(-LocalExtent,-LocalExtent,0.f) + ((LocalM-1)*3 + 2)*NewElem.GridSpacing*FVector(0.f,1.f,0.f)  + (LocalM-1)*NewElem.GridSpacing*FVector(1.f,0.f,0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,(LocalM-1)*2+3, (LocalM-1)-2+1, Triangles, Vertices, UV, UV1,UV2, NewElem.GridSpacing, LocalOffset, StichingProfile);
-		
-		
-		StichingProfile = 1<<3|1<<2|1;
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f)+ ((N-1) - 2) *NewElem.GridSpacing*FVector(0.f,1.f,0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,N,3,Triangles,Vertices,UV,UV1,UV2,NewElem.GridSpacing,LocalOffset,StichingProfile);
-		
-		StichingProfile = 1<<3;
-		LocalOffset = FVector(-LocalExtent,-LocalExtent,0.f) + (2) * NewElem.GridSpacing * FVector(0.f, 1.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,LocalM, N-4 /*LocalM*2+1+2*/, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		StichingProfile = 1<<2;
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + (2) * NewElem.GridSpacing * FVector(0.f, 1.f, 0.f) + ((LocalM - 1)*3+2) * NewElem.GridSpacing * FVector(1.f, 0.f, 0.f) ;
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,LocalM, N-4/*LocalM*2+1 +2*/, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		Normals.Empty();
-		Normals.Init(FVector(0.f, 0.f, 1.f), Vertices.Num());
-		Tangents.Empty();
-		Tangents.Init(FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false), Vertices.Num());
-
-		if(NewElem.Mesh)
-		NewElem.Mesh->CreateMeshSection(1, Vertices, Triangles, Normals, UV, UV1, UV2, UV_dummy, Color_dummy, Tangents, false);
-
-		if (NewElem.I_Mesh)
-		{
-			int NumI = Vertices.Num();
-			TArray<FTransform> InstanceT;
-			InstanceT.SetNum(NumI);
-			float ScaleLocal = pow(2.0, -i + Level - 1);
-
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
+				TArray<FVector> UnitVertices;
+				for (const FGeoClipmapGridPatch& Patch : Patches)
 				{
-					FTransform& T = InstanceT[k];
-					T.SetLocation(Vertices[k]);
-					T.SetRotation(FQuat::Identity);
-					T.SetScale3D(NewElem.GridSpacing/100.f*FVector(1.f, 1.f, 1.f));
+					for (int32 LocalIdx = 0; LocalIdx < Patch.GetNumVertices(); LocalIdx++)
+					{
+						const FGeoClipmapCompactVertex Compact = Patch.GetCompactVertex(LocalIdx);
+						UnitVertices.Add(FVector(Compact.X, Compact.Y, Compact.Flags & GeoClipmapVertex_JitterDown ? -RingKey.VerticalJitter : RingKey.VerticalJitter));
+					}
 				}
 
-			});
-
-			TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
+				int NumI = UnitVertices.Num();
+				TArray<FTransform> InstanceT;
+				InstanceT.SetNum(NumI);
 
-			if(!(Indexes.Num()!=NumI || UV.Num()!=NumI|| UV1.Num()!=NumI))
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
+				ParallelFor(NumI, [&](int32 k)
 				{
-					TArray<float> CustomData;
-					//Section Indentifier
-					CustomData.Add(1.f);
-					CustomData.Add(UV[k].X);
-					CustomData.Add(UV[k].Y);
-					CustomData.Add(UV1[k].X);
-					CustomData.Add(UV1[k].Y);
-					NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
-				}
-
-			});
-		}
+					const FVector& Unit = UnitVertices[k];
 
-
-		Vertices.Empty();
-		Triangles.Empty();
-		UV.Empty();
-		UV1.Empty();
-		UV2.Empty();
-		//inner L Shape have no stiching
-		StichingProfile = 0;
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,LocalM*2+1, 2, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f) + (1.0) * NewElem.GridSpacing * FVector(0.f, 1.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,2, LocalM * 2, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		Normals.Empty();
-		Normals.Init(FVector(0.f, 0.f, 1.f), Vertices.Num());
-		Tangents.Empty();
-		Tangents.Init(FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false), Vertices.Num());
-		
-		// botleft
-		if(NewElem.Mesh)
-		NewElem.Mesh->CreateMeshSection(2, Vertices, Triangles, Normals, UV, UV1, UV2, UV_dummy, Color_dummy, Tangents, false); 
-
-		if (NewElem.I_Mesh)
-		{
-			int NumI = Vertices.Num();
-			TArray<FTransform> InstanceT;
-			InstanceT.SetNum(NumI);
-			float ScaleLocal = pow(2.0, -i + Level - 1);
-
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
-				{
 					FTransform& T = InstanceT[k];
-					T.SetLocation(Vertices[k]);
+					T.SetLocation(FVector(Unit.X * NewElem.GridSpacing, Unit.Y * NewElem.GridSpacing, Unit.Z));
 					T.SetRotation(FQuat::Identity);
-					T.SetScale3D(NewElem.GridSpacing/100.f*FVector(1.f, 1.f, 1.f));
-				}
-
-			});
-
-			TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
-
-			if(!(Indexes.Num()!=NumI || UV.Num()!=NumI|| UV1.Num()!=NumI))
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
-				{
-					TArray<float> CustomData;
-					//Section Indentifier
-					CustomData.Add(2.f);
-					CustomData.Add(UV[k].X);
-					CustomData.Add(UV[k].Y);
-					CustomData.Add(UV1[k].X);
-					CustomData.Add(UV1[k].Y);
-					NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
-				}
-
-			});
-		}
-
-		Vertices.Empty();
-		Triangles.Empty();
-		UV.Empty();
-		UV1.Empty();
-		UV2.Empty();
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,LocalM * 2 + 1, 2, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f) + (1.0) * NewElem.GridSpacing * FVector(0.f, 1.f, 0.f)+ (LocalM *2 -1) * NewElem.GridSpacing * FVector(1.f, 0.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,2, LocalM * 2, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		Normals.Empty();
-		Normals.Init(FVector(0.f, 0.f, 1.f), Vertices.Num());
-		Tangents.Empty();
-		Tangents.Init(FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false), Vertices.Num());
-		
-		// topleft
-		if(NewElem.Mesh)
-		NewElem.Mesh->CreateMeshSection(3, Vertices, Triangles, Normals, UV, UV1, UV2, UV_dummy, Color_dummy, Tangents, false);
+					T.SetScale3D(NewElem.GridSpacing/100.f* FVector(1.f,1.f,1.f));
+				});
 
-		if (NewElem.I_Mesh)
-		{
-			int NumI = Vertices.Num();
-			TArray<FTransform> InstanceT;
-			InstanceT.SetNum(NumI);
-			float ScaleLocal = pow(2.0, -i + Level - 1);
+				const TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
 
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
+				if(Indexes.Num()==NumI)
 				{
-					FTransform& T = InstanceT[k];
-					T.SetLocation(Vertices[k]);
-					T.SetRotation(FQuat::Identity);
-					T.SetScale3D(NewElem.GridSpacing/100.f*FVector(1.f, 1.f, 1.f));
+					ParallelFor(NumI, [&](int32 k)
+					{
+						const FVector2D UnitPos = FVector2D(UnitVertices[k].X, UnitVertices[k].Y);
+						const FVector2D LevelPos = UnitPos * NewElem.GridSpacing;
+
+						TArray<float> CustomData;
+						//Section Indentifier
+						CustomData.Add((float)SectionID);
+						CustomData.Add(FMath::Frac(LevelPos.X/400000.f));
+						CustomData.Add(FMath::Frac(LevelPos.Y/400000.f));
+						CustomData.Add(UnitPos.X);
+						CustomData.Add(UnitPos.Y);
+
+						NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
+					});
 				}
-
-			});
-
-			TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
-
-			if(!(Indexes.Num()!=NumI || UV.Num()!=NumI|| UV1.Num()!=NumI))
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
+				else
 				{
-					TArray<float> CustomData;
-					//Section Indentifier
-					CustomData.Add(3.f);
-					CustomData.Add(UV[k].X);
-					CustomData.Add(UV[k].Y);
-					CustomData.Add(UV1[k].X);
-					CustomData.Add(UV1[k].Y);
-					NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
+					UE_LOG(LogTemp,Warning,TEXT("Indexes.Num %d Vertices num %d"),Indexes.Num(),NumI);
 				}
-
-			});
+			}
 		}
-
-		Vertices.Empty();
-		Triangles.Empty();
-		UV.Empty();
-		UV1.Empty();
-		UV2.Empty();
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,2, LocalM * 2 + 1, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f) + (LocalM*2.0-1.0) * NewElem.GridSpacing * FVector(0.f, 1.f, 0.f)+ (1.0) * NewElem.GridSpacing * FVector(1.f, 0.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,LocalM * 2, 2, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		Normals.Empty();
-		Normals.Init(FVector(0.f, 0.f, 1.f), Vertices.Num());
-		Tangents.Empty();
-		Tangents.Init(FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false), Vertices.Num());
-		
-		// botright
-		if(NewElem.Mesh)
-		NewElem.Mesh->CreateMeshSection(4, Vertices, Triangles, Normals, UV, UV1, UV2, UV_dummy, Color_dummy, Tangents, false);
-
-		if (NewElem.I_Mesh)
+		else
 		{
-			int NumI = Vertices.Num();
-			TArray<FTransform> InstanceT;
-			InstanceT.SetNum(NumI);
-			float ScaleLocal = pow(2.0, -i + Level - 1);
-
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
-				{
-					FTransform& T = InstanceT[k];
-					T.SetLocation(Vertices[k]);
-					T.SetRotation(FQuat::Identity);
-					T.SetScale3D(NewElem.GridSpacing/100.f*FVector(1.f, 1.f, 1.f));
-				}
-
-			});
-
-			TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
-
-			if(!(Indexes.Num()!=NumI || UV.Num()!=NumI|| UV1.Num()!=NumI))
-			ParallelFor(NumI, [&](int32 k)
+			// Every level is drawn by the same component, and scene proxy
+			if (!ClipMapMesh)
 			{
-				if (k < NumI)
-				{
-					TArray<float> CustomData;
-					//Section Indentifier
-					CustomData.Add(4.f);
-					CustomData.Add(UV[k].X);
-					CustomData.Add(UV[k].Y);
-					CustomData.Add(UV1[k].X);
-					CustomData.Add(UV1[k].Y);
-					NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
-				}
-
-			});
-		}
-
-		Vertices.Empty();
-		Triangles.Empty();
-		UV.Empty();
-		UV1.Empty();
-		UV2.Empty();
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f)+ (LocalM * 2.0 - 1.0) * NewElem.GridSpacing * FVector(1.f, 0.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,2, LocalM * 2 + 1, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		LocalOffset = FVector(-LocalExtent, -LocalExtent, 0.f) + ((LocalM - 1)) * NewElem.GridSpacing * FVector(1.f, 1.f, 0.f) + (LocalM * 2.0 - 1.0) * NewElem.GridSpacing * FVector(0.f, 1.f, 0.f);
-		if (NewElem.I_Mesh)
-			StichingProfile = 0;
-		CreateGridMeshWelded(LOD,LocalM * 2, 2, Triangles, Vertices, UV,UV1,UV2, NewElem.GridSpacing, LocalOffset,StichingProfile);
-
-		Normals.Empty();
-		Normals.Init(FVector(0.f, 0.f, 1.f), Vertices.Num());
-		Tangents.Empty();
-		Tangents.Init(FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false), Vertices.Num());
-		
-		// topright
-		if(NewElem.Mesh)
-		NewElem.Mesh->CreateMeshSection(5, Vertices, Triangles, Normals, UV, UV1, UV2, UV_dummy, Color_dummy, Tangents, false);
+				ClipMapMesh = NewObject<UGeoClipmapMeshComponent>(this, NAME_None, RF_Transient);
+				ClipMapMesh->SetupAttachment(RootComponent);
+				ClipMapMesh->RegisterComponent();
 
+				ClipMapMesh->bUseComplexAsSimpleCollision = true;
+				ClipMapMesh->bNeverDistanceCull = true;
 
-		if (NewElem.I_Mesh)
-		{
-			int NumI = Vertices.Num();
-			TArray<FTransform> InstanceT;
-			InstanceT.SetNum(NumI);
-			float ScaleLocal = pow(2.0, -i + Level - 1);
-
-			ParallelFor(NumI, [&](int32 k)
-			{
-				if (k < NumI)
-				{
-					FTransform& T = InstanceT[k];
-					T.SetLocation(Vertices[k]);
-					T.SetRotation(FQuat::Identity);
-					T.SetScale3D(NewElem.GridSpacing/100.f*FVector(1.f, 1.f, 1.f));
-				}
+				ClipMapMesh->CastShadow = true;
+				ClipMapMesh->bCastFarShadow = true;
+			}
 
-			});
+			NewElem.Mesh = ClipMapMesh;
 
-			TArray<int32> Indexes = NewElem.I_Mesh->AddInstances(InstanceT,true);
+			// Ring geometry is unit scaled, only the planar axes are scaled so the culling hack keeps its height
+			NewElem.MeshLevel = NewElem.Mesh->AddLevel(FVector(-NewElem.GridSpacing, -NewElem.GridSpacing, 0.f), FVector(NewElem.GridSpacing, NewElem.GridSpacing, 1.f));
+			NewElem.FirstSection = NewElem.MeshLevel * GeoClipmapRingSection::Num;
 
-			if(!(Indexes.Num()!=NumI || UV.Num()!=NumI|| UV1.Num()!=NumI))
-			ParallelFor(NumI, [&](int32 k)
+			for (int SectionID = 0; SectionID < GeoClipmapRingSection::Num; SectionID++)
 			{
-				if (k < NumI)
-				{
-					TArray<float> CustomData;
-					//Section Indentifier
-					CustomData.Add(5.f);
-					CustomData.Add(UV[k].X);
-					CustomData.Add(UV[k].Y);
-					CustomData.Add(UV1[k].X);
-					CustomData.Add(UV1[k].Y);
-					NewElem.I_Mesh->SetCustomData(Indexes[k], CustomData);
-				}
+				NewElem.Mesh->SetSharedMeshSection(NewElem.FirstSection + SectionID, RingGeometry->GetMesh(), RingGeometry->GetSectionRange(SectionID), RingGeometry->GetSectionBlocks(SectionID));
+				NewElem.Mesh->SetSectionLevel(NewElem.FirstSection + SectionID, NewElem.MeshLevel);
+			}
 
-			});
+			if (EnableCaching && CacheHeightBounds)
+				UpdateLevelHeightBounds(NewElem);
 		}
 
 
-		LocalOffset = FVector(-LocalExtent,-LocalExtent,0.f);
-
 		if(NewElem.SectionVisibility.Num()!=6)
 		{
 			NewElem.SectionVisibility.SetNum(6);
@@ -1894,6 +1747,9 @@ void AGeometryClipMapWorld::InitiateWorld()
 				//				
 
 			}
+
+			if (CacheHeightBounds)
+				RequestHeightBounds(NewElem);
 			
 		}
 
@@ -1921,12 +1777,10 @@ void AGeometryClipMapWorld::InitiateWorld()
 		{
 			if(NewElem.Mesh)
 			{
-				NewElem.Mesh->SetMaterial(0, NewElem.MatDyn);
-				NewElem.Mesh->SetMaterial(1, NewElem.MatDyn);
-				NewElem.Mesh->SetMaterial(2, NewElem.MatDyn);
-				NewElem.Mesh->SetMaterial(3, NewElem.MatDyn);
-				NewElem.Mesh->SetMaterial(4, NewElem.MatDyn);
-				NewElem.Mesh->SetMaterial(5, NewElem.MatDyn);
+				for (int SectionID = 0; SectionID < GeoClipmapRingSection::Num; SectionID++)
+				{
+					NewElem.Mesh->SetMaterial(NewElem.FirstSection + SectionID, NewElem.MatDyn);
+				}
 			}
 			if(NewElem.I_Mesh)
 				NewElem.I_Mesh->SetMaterial(0, NewElem.MatDyn);
@@ -2439,7 +2293,7 @@ void FClipMapMeshElement::SetSectionVisible(int SectionID,bool NewVisibility)
 		SectionVisibility[SectionID]=NewVisibility;
 
 		if(Mesh)
-			Mesh->SetMeshSectionVisible(SectionID,NewVisibility);
+			Mesh->SetMeshSectionVisible(FirstSection + SectionID,NewVisibility);
 		
 		if(I_Mesh)
 		{
@@ -0,0 +1,673 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "GeoClipmapGridIndices.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace GeoClipmapGridIndicesPrivate
+{
+	FORCEINLINE void EmitTriangle(int32*& Out, int32 A, int32 B, int32 C)
+	{
+		Out[0] = A;
+		Out[1] = B;
+		Out[2] = C;
+		Out += 3;
+	}
+
+	FORCEINLINE void EmitQuad(int32*& Out, int32 idx, int32 NumX)
+	{
+		EmitTriangle(Out, idx, idx + NumX, idx + 1);
+		EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+	}
+
+	/** Upper bound of the index count, a stitched corner cell can emit up to 6 triangles */
+	FORCEINLINE int32 MaxNumIndices(int32 NumX, int32 NumY)
+	{
+		return 6 * (NumX - 1) * (NumY - 1) + 12 * 2 * ((NumX - 1) + (NumY - 1));
+	}
+
+	/** Cell on the border of a stitched grid, same output as the reference generator */
+	template<uint8 StitchProfil>
+	FORCEINLINE void EmitBorderCell(int32*& Out, int32 i, int32 j, int32 NumX, int32 NumY, int32 idx)
+	{
+		constexpr bool StitchX0 = (((StitchProfil >> 3) & 1) > 0);
+		constexpr bool StitchXN = (((StitchProfil >> 2) & 1) > 0);
+		constexpr bool StitchY0 = (((StitchProfil >> 1) & 1) > 0);
+		constexpr bool StitchYN = ((StitchProfil & 1) > 0);
+
+	if(i==0)
+	{
+		if (StitchY0)
+		{
+			if (j % 2 == 0 && j < NumX - 2)
+			{
+				if (j>0)
+				{
+					EmitTriangle(Out, idx, idx + NumX, idx + 1 + NumX);
+				}
+
+				EmitTriangle(Out, idx, idx + 1 + NumX, idx + 2);
+
+				if(j+2<NumX - 2)
+				{
+					EmitTriangle(Out, idx + 2, idx + 1 + NumX, idx + 2 + NumX);
+				}
+
+			}
+		}
+		else
+		{
+
+			if(j==0 && StitchX0)
+			{
+				EmitTriangle(Out, idx, idx + 1 + NumX, idx + 1);
+			}
+			else if (j == NumX - 2)
+			{
+				EmitTriangle(Out, idx, idx + NumX, idx + 1);
+			}
+			else
+			{
+				EmitTriangle(Out, idx, idx + NumX, idx + 1);
+
+				EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+			}
+
+
+		}
+	}
+	if (i == NumY - 2)
+	{
+		if (StitchYN)
+		{
+			if (j % 2 == 0 && j < NumX - 2)
+			{
+				if (j > 0)
+				{
+					EmitTriangle(Out, idx, idx + NumX, idx + 1);
+				}
+
+				EmitTriangle(Out, idx + NumX, idx + 2 + NumX, idx + 1);
+
+				if (j + 2 < NumX - 2)
+				{
+					EmitTriangle(Out, idx + 1, idx + 2 + NumX, idx + 2);
+				}
+
+			}
+		}
+		else
+		{
+
+			if (j == 0)
+			{
+				EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+			}
+			else if (j == NumX - 2 && StitchXN)
+			{
+				EmitTriangle(Out, idx, idx + NumX, idx + 1 + NumX);
+			}
+			else
+			{
+				EmitTriangle(Out, idx, idx + NumX, idx + 1);
+
+				EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+			}
+
+		}
+	}
+	if (j == 0)
+	{
+		if(StitchX0)
+		{
+			if (i % 2 == 0 && i < NumY - 2)
+			{
+
+				EmitTriangle(Out, idx, idx + 2 * NumX, idx + NumX + 1);
+
+				if (i > 0)
+				{
+					EmitTriangle(Out, idx + 1, idx, idx + NumX + 1);
+				}
+
+				if (i + 2 < NumY - 2)
+				{
+					EmitTriangle(Out, idx + 1 + NumX, idx + 2*NumX, idx + 2*NumX + 1);
+				}
+
+
+			}
+
+		}
+		else
+		{
+
+			if (i > 0 && i<NumY - 2)
+			{
+				EmitTriangle(Out, idx, idx + NumX, idx + 1);
+
+				EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+			}
+			else
+			{
+				if(i==0 && StitchY0)
+				{
+					EmitTriangle(Out, idx, idx + NumX, idx + NumX + 1);
+				}
+				else
+				{
+					EmitTriangle(Out, idx, idx + NumX, idx + 1);
+
+					EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+				}
+
+
+			}
+
+		}
+
+	}
+	if (j == NumX - 2)
+	{
+
+		if (StitchXN)
+		{
+			if (i % 2 == 0 && i < NumY - 2)
+			{
+
+				EmitTriangle(Out, idx+1, idx + NumX, idx + 1 + 2 * NumX);
+
+				if (i > 0)
+				{
+					EmitTriangle(Out, idx + 1, idx, idx + NumX);
+				}
+
+				if (i + 2 < NumY - 2)
+				{
+					EmitTriangle(Out, idx + NumX, idx + 2 * NumX, idx + 2 * NumX + 1);
+				}
+
+
+			}
+
+		}
+		else
+		{
+
+			if(i>0 && i<NumY - 2)
+			{
+				EmitTriangle(Out, idx, idx + NumX, idx + 1);
+
+				EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+			}
+			else if(i<NumY - 2)
+			{
+				EmitTriangle(Out, idx + 1, idx + NumX, idx + NumX + 1);
+			}
+
+		}
+
+	}
+
+
+	}
+
+	/** Returns the number of indices written in Out, which must hold MaxNumIndices */
+	template<uint8 StitchProfil>
+	int32 GenerateGrid(int32 NumX, int32 NumY, int32* Out)
+	{
+		int32* const Start = Out;
+
+		if (NumX < 2 || NumY < 2)
+			return 0;
+
+		if (StitchProfil == 0 || NumX == 2 || NumY == 2)
+		{
+			for (int32 i = 0; i < NumY - 1; i++)
+			{
+				for (int32 j = 0; j < NumX - 1; j++)
+				{
+					EmitQuad(Out, j + i * NumX, NumX);
+				}
+			}
+			return Out - Start;
+		}
+
+		for (int32 i = 0; i < NumY - 1; i++)
+		{
+			const int32 Row = i * NumX;
+
+			if (i == 0 || i == NumY - 2)
+			{
+				for (int32 j = 0; j < NumX - 1; j++)
+				{
+					EmitBorderCell<StitchProfil>(Out, i, j, NumX, NumY, j + Row);
+				}
+			}
+			else
+			{
+				EmitBorderCell<StitchProfil>(Out, i, 0, NumX, NumY, Row);
+
+				for (int32 j = 1; j < NumX - 2; j++)
+				{
+					EmitQuad(Out, j + Row, NumX);
+				}
+
+				EmitBorderCell<StitchProfil>(Out, i, NumX - 2, NumX, NumY, NumX - 2 + Row);
+			}
+		}
+
+		return Out - Start;
+	}
+
+	typedef int32(*FGridGenerator)(int32, int32, int32*);
+
+	static const FGridGenerator Generators[16] =
+	{
+		&GenerateGrid<0>, &GenerateGrid<1>, &GenerateGrid<2>, &GenerateGrid<3>,
+		&GenerateGrid<4>, &GenerateGrid<5>, &GenerateGrid<6>, &GenerateGrid<7>,
+		&GenerateGrid<8>, &GenerateGrid<9>, &GenerateGrid<10>, &GenerateGrid<11>,
+		&GenerateGrid<12>, &GenerateGrid<13>, &GenerateGrid<14>, &GenerateGrid<15>,
+	};
+
+	static FCriticalSection TablesLock;
+	static TMap<FIntVector, TUniquePtr<TArray<int32>>> Tables;
+	/** Number of FScopedTables alive */
+	static int32 NumTablesUsers = 0;
+}
+
+GeoClipmapGridIndices::FScopedTables::FScopedTables()
+{
+	using namespace GeoClipmapGridIndicesPrivate;
+
+	FScopeLock Lock(&TablesLock);
+	NumTablesUsers++;
+}
+
+GeoClipmapGridIndices::FScopedTables::~FScopedTables()
+{
+	using namespace GeoClipmapGridIndicesPrivate;
+
+	FScopeLock Lock(&TablesLock);
+	if (--NumTablesUsers == 0)
+	{
+		Tables.Empty();
+	}
+}
+
+void GeoClipmapGridIndices::Generate(int32 NumX, int32 NumY, uint8 StitchProfile, TArray<int32>& Triangles)
+{
+	using namespace GeoClipmapGridIndicesPrivate;
+
+	Triangles.SetNumUninitialized(FMath::Max(0, MaxNumIndices(NumX, NumY)));
+	const int32 NumIndices = Generators[StitchProfile & 0b1111](NumX, NumY, Triangles.GetData());
+	Triangles.SetNum(NumIndices, false);
+}
+
+const TArray<int32>& GeoClipmapGridIndices::FindOrCreate(int32 NumX, int32 NumY, uint8 StitchProfile)
+{
+	using namespace GeoClipmapGridIndicesPrivate;
+
+	const FIntVector Key(NumX, NumY, StitchProfile & 0b1111);
+
+	FScopeLock Lock(&TablesLock);
+	ensureMsgf(NumTablesUsers > 0, TEXT("GeoClipmap grid index table %dx%d used outside of an FScopedTables, it is kept until the next scope ends"), NumX, NumY);
+
+	if (TUniquePtr<TArray<int32>>* Found = Tables.Find(Key))
+	{
+		return **Found;
+	}
+
+	TArray<int32>* Table = new TArray<int32>();
+	Generate(NumX, NumY, StitchProfile, *Table);
+	Table->Shrink();
+	Tables.Add(Key, TUniquePtr<TArray<int32>>(Table));
+
+	return *Table;
+}
+
+void GeoClipmapGridIndices::Append(int32 NumX, int32 NumY, uint8 StitchProfile, int32 IDOffset, TArray<int32>& Triangles)
+{
+	const TArray<int32>& Table = FindOrCreate(NumX, NumY, StitchProfile);
+
+	const int32 Start = Triangles.Num();
+	Triangles.SetNumUninitialized(Start + Table.Num());
+
+	if (IDOffset == 0)
+	{
+		FMemory::Memcpy(Triangles.GetData() + Start, Table.GetData(), Table.Num() * sizeof(int32));
+	}
+	else
+	{
+		int32* Out = Triangles.GetData() + Start;
+		for (int32 Index : Table)
+		{
+			*Out++ = Index + IDOffset;
+		}
+	}
+}
+
+void GeoClipmapGridIndices::GenerateReference(int32 NumX, int32 NumY, uint8 StitchProfil, int32 IDOffset, TArray<int32>& Triangles)
+{
+	bool StitchX0 = (((StitchProfil>>3) & 1) > 0);
+	bool StitchXN = (((StitchProfil>>2) & 1) > 0);
+
+	bool StitchY0 = (((StitchProfil >> 1) & 1) > 0);
+	bool StitchYN = ((StitchProfil & 1) > 0);
+
+	if (NumX >= 2 && NumY >= 2)
+	{
+	for (int i = 0; i < NumY - 1; i++)
+	{
+		for (int j = 0; j < NumX - 1; j++)
+		{
+			int idx = j + (i * NumX) + IDOffset;
+
+			if(i>0 && i<NumY - 2 && j>0 && j<NumX - 2 || NumX==2 || NumY==2|| !StitchX0 && !StitchXN && !StitchY0 && !StitchYN)
+			{
+				Triangles.Add(idx);
+				Triangles.Add(idx + NumX);
+				Triangles.Add(idx + 1);
+
+				Triangles.Add(idx + 1);
+				Triangles.Add(idx + NumX);
+				Triangles.Add(idx + NumX + 1);
+			}
+			else
+			{
+				if(i==0)
+				{
+					if (StitchY0)
+					{
+						if (j % 2 == 0 && j < NumX - 2)
+						{
+							if (j>0)
+							{
+								Triangles.Add(idx);
+								Triangles.Add(idx + NumX);
+								Triangles.Add(idx + 1 + NumX);
+							}
+
+							Triangles.Add(idx);
+							Triangles.Add(idx + 1 + NumX);
+							Triangles.Add(idx + 2);
+
+							if(j+2<NumX - 2)
+							{
+								Triangles.Add(idx + 2);
+								Triangles.Add(idx + 1 + NumX);
+								Triangles.Add(idx + 2 + NumX);
+							}
+
+						}
+					}
+					else
+					{
+
+						if(j==0 && StitchX0)
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + 1 + NumX);
+							Triangles.Add(idx + 1);
+						}
+						else if (j == NumX - 2)
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1);
+						}
+						else
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1);
+
+							Triangles.Add(idx + 1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + NumX + 1);
+						}
+
+
+					}
+				}
+				if (i == NumY - 2)
+				{
+					if (StitchYN)
+					{
+						if (j % 2 == 0 && j < NumX - 2)
+						{
+							if (j > 0)
+							{
+								Triangles.Add(idx);
+								Triangles.Add(idx + NumX);
+								Triangles.Add(idx + 1);
+							}
+
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 2 + NumX);
+							Triangles.Add(idx + 1);
+
+							if (j + 2 < NumX - 2)
+							{
+								Triangles.Add(idx + 1);
+								Triangles.Add(idx + 2 + NumX);
+								Triangles.Add(idx + 2);
+							}
+
+						}
+					}
+					else
+					{
+
+						if (j == 0)
+						{
+							Triangles.Add(idx + 1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + NumX + 1);
+						}
+						else if (j == NumX - 2 && StitchXN)
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1 + NumX);
+						}
+						else
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1);
+
+							Triangles.Add(idx + 1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + NumX + 1);
+						}
+
+					}
+				}
+				if (j == 0)
+				{
+					if(StitchX0)
+					{
+						if (i % 2 == 0 && i < NumY - 2)
+						{
+
+							Triangles.Add(idx);
+							Triangles.Add(idx + 2 * NumX);
+							Triangles.Add(idx + NumX + 1);
+
+							if (i > 0)
+							{
+								Triangles.Add(idx + 1);
+								Triangles.Add(idx);
+								Triangles.Add(idx + NumX + 1);
+							}
+
+							if (i + 2 < NumY - 2)
+							{
+								Triangles.Add(idx + 1 + NumX);
+								Triangles.Add(idx + 2*NumX);
+								Triangles.Add(idx + 2*NumX + 1);
+							}
+
+
+						}
+
+					}
+					else
+					{
+
+						if (i > 0 && i<NumY - 2)
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1);
+
+							Triangles.Add(idx + 1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + NumX + 1);
+						}
+						else
+						{
+							if(i==0 && StitchY0)
+							{
+								Triangles.Add(idx);
+								Triangles.Add(idx + NumX);
+								Triangles.Add(idx + NumX + 1);
+							}
+							else
+							{
+								Triangles.Add(idx);
+								Triangles.Add(idx + NumX);
+								Triangles.Add(idx + 1);
+
+								Triangles.Add(idx + 1);
+								Triangles.Add(idx + NumX);
+								Triangles.Add(idx + NumX + 1);
+							}
+
+
+						}
+
+					}
+
+				}
+				if (j == NumX - 2)
+				{
+
+					if (StitchXN)
+					{
+						if (i % 2 == 0 && i < NumY - 2)
+						{
+
+							Triangles.Add(idx+1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1 + 2 * NumX);
+
+							if (i > 0)
+							{
+								Triangles.Add(idx + 1);
+								Triangles.Add(idx);
+								Triangles.Add(idx + NumX);
+							}
+
+							if (i + 2 < NumY - 2)
+							{
+								Triangles.Add(idx + NumX);
+								Triangles.Add(idx + 2 * NumX);
+								Triangles.Add(idx + 2 * NumX + 1);
+							}
+
+
+						}
+
+					}
+					else
+					{
+
+						if(i>0 && i<NumY - 2)
+						{
+							Triangles.Add(idx);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + 1);
+
+							Triangles.Add(idx + 1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + NumX + 1);
+						}
+						else if(i<NumY - 2)
+						{
+							Triangles.Add(idx + 1);
+							Triangles.Add(idx + NumX);
+							Triangles.Add(idx + NumX + 1);
+						}
+
+					}
+
+				}
+
+
+			}
+
+
+		}
+	}
+	}
+}
+
+static void BenchmarkGridIndices(const TArray<FString>& Args)
+{
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10;
+	const int32 NValues[] = { 511, 255, 127, 63, 31, 15 };
+
+	for (int32 N : NValues)
+	{
+		double ReferenceTime = 0.0;
+		double GeneratedTime = 0.0;
+		double CopyTime = 0.0;
+		int32 Mismatches = 0;
+
+		for (uint8 StitchProfile = 0; StitchProfile < 16; StitchProfile++)
+		{
+			GeoClipmapGridIndices::FScopedTables ScopedTables;
+
+			TArray<int32> Reference;
+			TArray<int32> Generated;
+			TArray<int32> Copied;
+
+			GeoClipmapGridIndices::FindOrCreate(N, N, StitchProfile);
+
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				Reference.Empty();
+				double Start = FPlatformTime::Seconds();
+				GeoClipmapGridIndices::GenerateReference(N, N, StitchProfile, 0, Reference);
+				ReferenceTime += FPlatformTime::Seconds() - Start;
+
+				Generated.Empty();
+				Start = FPlatformTime::Seconds();
+				GeoClipmapGridIndices::Generate(N, N, StitchProfile, Generated);
+				GeneratedTime += FPlatformTime::Seconds() - Start;
+
+				Copied.Empty();
+				Start = FPlatformTime::Seconds();
+				GeoClipmapGridIndices::Append(N, N, StitchProfile, 0, Copied);
+				CopyTime += FPlatformTime::Seconds() - Start;
+			}
+
+			if (Reference != Generated || Reference != Copied)
+			{
+				Mismatches++;
+				UE_LOG(LogTemp, Warning, TEXT("GeoClipmap grid indices mismatch N %d StitchProfile %d"), N, StitchProfile);
+			}
+		}
+
+		const double Runs = 16.0 * Iterations;
+		UE_LOG(LogTemp, Display, TEXT("GeoClipmap grid indices N %d : reference %.3f ms, specialised %.3f ms, cached copy %.3f ms, %d mismatch"),
+			N, 1000.0 * ReferenceTime / Runs, 1000.0 * GeneratedTime / Runs, 1000.0 * CopyTime / Runs, Mismatches);
+	}
+}
+
+static FAutoConsoleCommand CmdBenchmarkGridIndices(
+	TEXT("GeoClipmap.BenchmarkGridIndices"),
+	TEXT("Compare the reference clipmap grid index generator against the specialised and cached ones for every N and stitch profile. Optional argument: iterations (default 10)."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkGridIndices));
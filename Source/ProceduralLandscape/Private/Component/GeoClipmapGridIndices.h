@@ -0,0 +1,33 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+*	Index tables of the welded grids clipmap rings are made of.
+*	Tables are generated once per (NumX, NumY, StitchProfile) by a generator specialised on the stitch profile
+*	and are then appended with a copy. They are only kept while an FScopedTables is alive, rings are cached once built.
+*	StitchProfile: 1<<3 X=0 | 1<<2 X=N-1 | 1<<1 Y=0 | 1 Y=N-1
+*/
+namespace GeoClipmapGridIndices
+{
+	/** Keeps the tables cached while alive, the last one going out of scope frees them. Thread safe. */
+	struct FScopedTables
+	{
+		FScopedTables();
+		~FScopedTables();
+	};
+
+	/** Returns the cached index table of a NumX*NumY grid, indices start at 0, valid while an FScopedTables is alive. Thread safe. */
+	const TArray<int32>& FindOrCreate(int32 NumX, int32 NumY, uint8 StitchProfile);
+
+	/** Append the indices of a NumX*NumY grid whose first vertex is IDOffset */
+	void Append(int32 NumX, int32 NumY, uint8 StitchProfile, int32 IDOffset, TArray<int32>& Triangles);
+
+	/** Generate the indices without going through the cache */
+	void Generate(int32 NumX, int32 NumY, uint8 StitchProfile, TArray<int32>& Triangles);
+
+	/** Original per cell generator, kept as the reference for GeoClipmap.BenchmarkGridIndices */
+	void GenerateReference(int32 NumX, int32 NumY, uint8 StitchProfile, int32 IDOffset, TArray<int32>& Triangles);
+}
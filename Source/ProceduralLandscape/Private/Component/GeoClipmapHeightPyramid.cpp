@@ -0,0 +1,82 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "Component/GeoClipmapHeightPyramid.h"
+
+void FGeoClipmapHeightPyramid::Build(TArrayView<const float> Heights, int32 Resolution)
+{
+	Mips.Reset();
+
+	if (Resolution <= 0 || Heights.Num() < Resolution * Resolution)
+	{
+		return;
+	}
+
+	FMip& Base = Mips.AddDefaulted_GetRef();
+	Base.Size = Resolution;
+	Base.MinMax.SetNumUninitialized(Resolution * Resolution);
+	for (int32 TexelIdx = 0; TexelIdx < Resolution * Resolution; TexelIdx++)
+	{
+		Base.MinMax[TexelIdx] = FVector2f(Heights[TexelIdx], Heights[TexelIdx]);
+	}
+
+	while (Mips.Last().Size > 1)
+	{
+		const int32 ParentSize = Mips.Last().Size;
+		const int32 Size = (ParentSize + 1) / 2;
+
+		FMip Mip;
+		Mip.Size = Size;
+		Mip.MinMax.SetNumUninitialized(Size * Size);
+
+		const TArray<FVector2f>& Parent = Mips.Last().MinMax;
+		for (int32 Y = 0; Y < Size; Y++)
+		{
+			for (int32 X = 0; X < Size; X++)
+			{
+				// Odd sizes, the last cell only covers one row or column of the parent
+				const int32 X1 = FMath::Min(X * 2 + 1, ParentSize - 1);
+				const int32 Y1 = FMath::Min(Y * 2 + 1, ParentSize - 1);
+				const FVector2f& A = Parent[Y * 2 * ParentSize + X * 2];
+				const FVector2f& B = Parent[Y * 2 * ParentSize + X1];
+				const FVector2f& C = Parent[Y1 * ParentSize + X * 2];
+				const FVector2f& D = Parent[Y1 * ParentSize + X1];
+
+				Mip.MinMax[Y * Size + X] = FVector2f(
+					FMath::Min(FMath::Min(A.X, B.X), FMath::Min(C.X, D.X)),
+					FMath::Max(FMath::Max(A.Y, B.Y), FMath::Max(C.Y, D.Y)));
+			}
+		}
+
+		Mips.Add(MoveTemp(Mip));
+	}
+}
+
+bool FGeoClipmapHeightPyramid::GetHeightRange(const FIntPoint& MinTexel, const FIntPoint& MaxTexel, float& OutMinHeight, float& OutMaxHeight) const
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	const int32 Resolution = GetResolution();
+	const FIntPoint Min(FMath::Clamp(MinTexel.X, 0, Resolution - 1), FMath::Clamp(MinTexel.Y, 0, Resolution - 1));
+	const FIntPoint Max(FMath::Clamp(MaxTexel.X, Min.X, Resolution - 1), FMath::Clamp(MaxTexel.Y, Min.Y, Resolution - 1));
+
+	// Coarsest mip where the rectangle still spans a few cells per axis
+	const int32 Span = FMath::Max(Max.X - Min.X, Max.Y - Min.Y) + 1;
+	const int32 MipIndex = FMath::Clamp((int32)FMath::FloorLog2(Span) - 1, 0, Mips.Num() - 1);
+	const FMip& Mip = Mips[MipIndex];
+
+	OutMinHeight = MAX_flt;
+	OutMaxHeight = -MAX_flt;
+	for (int32 Y = Min.Y >> MipIndex; Y <= Max.Y >> MipIndex; Y++)
+	{
+		for (int32 X = Min.X >> MipIndex; X <= Max.X >> MipIndex; X++)
+		{
+			const FVector2f& Cell = Mip.MinMax[Y * Mip.Size + X];
+			OutMinHeight = FMath::Min(OutMinHeight, Cell.X);
+			OutMaxHeight = FMath::Max(OutMaxHeight, Cell.Y);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,181 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "Component/GeoClipmapHeightfieldComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Engine/CollisionProfile.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Physics/PhysicsFiltering.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#include "Chaos/HeightField.h"
+#include "Chaos/ParticleHandle.h"
+
+UGeoClipmapHeightfieldComponent::UGeoClipmapHeightfieldComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
+	SetGenerateOverlapEvents(false);
+}
+
+void UGeoClipmapHeightfieldComponent::SetGrid(int32 InNumVertices, float InSpacing)
+{
+	NumVertices = InNumVertices;
+	Spacing = InSpacing;
+
+	Heights.Reset();
+	MinHeight = 0.f;
+	MaxHeight = 0.f;
+
+	RecreatePhysicsState();
+	UpdateBounds();
+}
+
+void UGeoClipmapHeightfieldComponent::SetHeights(TArray<float>&& InHeights)
+{
+	if (InHeights.Num() != NumVertices * NumVertices)
+		return;
+
+	Heights = MoveTemp(InHeights);
+
+	MinHeight = Heights[0];
+	MaxHeight = Heights[0];
+	for (const float Height : Heights)
+	{
+		MinHeight = FMath::Min(MinHeight, Height);
+		MaxHeight = FMath::Max(MaxHeight, Height);
+	}
+
+	// Rebuilding the body is cheap, there is nothing to cook
+	RecreatePhysicsState();
+	UpdateBounds();
+}
+
+FBox UGeoClipmapHeightfieldComponent::GetLocalBox() const
+{
+	const float Extent = FMath::Max(NumVertices - 1, 0) * Spacing;
+	return FBox(FVector(0.f, 0.f, MinHeight), FVector(Extent, Extent, MaxHeight));
+}
+
+float UGeoClipmapHeightfieldComponent::GetQuantizationStep() const
+{
+	return (MaxHeight - MinHeight) / MAX_uint16;
+}
+
+FBoxSphereBounds UGeoClipmapHeightfieldComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	return FBoxSphereBounds(GetLocalBox().TransformBy(LocalToWorld));
+}
+
+bool UGeoClipmapHeightfieldComponent::ShouldCreatePhysicsState() const
+{
+	return NumVertices > 1 && Heights.Num() == NumVertices * NumVertices && Super::ShouldCreatePhysicsState();
+}
+
+void UGeoClipmapHeightfieldComponent::OnCreatePhysicsState()
+{
+	// Skip the UPrimitiveComponent body creation, there is no body setup to build it from
+	USceneComponent::OnCreatePhysicsState();
+
+	FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr;
+	if (!PhysScene || BodyInstance.IsValidBodyInstance())
+		return;
+
+	TArray<Chaos::FReal> ChaosHeights;
+	ChaosHeights.SetNumUninitialized(Heights.Num());
+	for (int32 Index = 0; Index < Heights.Num(); Index++)
+	{
+		ChaosHeights[Index] = Heights[Index];
+	}
+
+	// Single physical material for every cell
+	TArray<uint8> MaterialIndices;
+	MaterialIndices.SetNumZeroed((NumVertices - 1) * (NumVertices - 1));
+
+	// Grid rows are along Y and columns along X, the same layout as the height data
+	TUniquePtr<Chaos::FHeightField> HeightField = MakeUnique<Chaos::FHeightField>(MoveTemp(ChaosHeights), MoveTemp(MaterialIndices), NumVertices, NumVertices, Chaos::FVec3(Spacing, Spacing, 1.f));
+
+	// Heights are stored on 16 bits between the lowest and highest vertex, vertices should be within half a step of their height
+	MaxHeightError = 0.f;
+	for (int32 Index = 0; Index < Heights.Num(); Index++)
+	{
+		MaxHeightError = FMath::Max(MaxHeightError, (float)FMath::Abs(HeightField->GetHeight(Index) - Heights[Index]));
+	}
+	if (MaxHeightError > GetQuantizationStep() * 0.5f + KINDA_SMALL_NUMBER)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: heightfield vertices are up to %f off their height, more than half the quantization step of %f"), *GetName(), MaxHeightError, GetQuantizationStep());
+	}
+
+	TUniquePtr<Chaos::FImplicitObject> Geometry = MoveTemp(HeightField);
+
+	const FTransform& ComponentTransform = GetComponentTransform();
+
+	FActorCreationParams Params;
+	Params.InitialTM = FTransform(ComponentTransform.GetRotation(), ComponentTransform.GetLocation());
+	Params.bQueryOnly = false;
+	Params.bStatic = true;
+	Params.Scene = PhysScene;
+	Params.DebugName = nullptr;
+
+	FPhysicsActorHandle PhysHandle;
+	FPhysicsInterface::CreateActor(Params, PhysHandle);
+	Chaos::FRigidBodyHandle_External& Body_External = PhysHandle->GetGameThreadAPI();
+
+	FCollisionFilterData QueryFilterData, SimFilterData;
+	CreateShapeFilterData(GetCollisionObjectType(), FMaskFilter(0), GetOwner() ? GetOwner()->GetUniqueID() : 0, GetCollisionResponseToChannels(), GetUniqueID(), 0, QueryFilterData, SimFilterData, false, false, true);
+
+	// Used as both simple and complex collision, as the procedural mesh tiles with bUseComplexAsSimpleCollision
+	QueryFilterData.Word3 |= EPDF_SimpleCollision | EPDF_ComplexCollision;
+	SimFilterData.Word3 |= EPDF_SimpleCollision | EPDF_ComplexCollision;
+
+	TArray<Chaos::FMaterialHandle> Materials;
+	if (UPhysicalMaterial* PhysMaterial = BodyInstance.GetSimplePhysicalMaterial())
+		Materials.Add(PhysMaterial->GetPhysicsMaterial());
+
+	TUniquePtr<Chaos::FPerShapeData> Shape = Chaos::FPerShapeData::CreatePerShapeData(0);
+	Shape->SetGeometry(MakeSerializable(Geometry));
+	Shape->SetQueryData(QueryFilterData);
+	Shape->SetSimData(SimFilterData);
+	Shape->SetMaterials(Materials);
+
+	Body_External.SetGeometry(MoveTemp(Geometry));
+
+	Shape->UpdateShapeBounds(Chaos::FRigidTransform3(Body_External.X(), Body_External.R()));
+
+	Chaos::FShapesArray Shapes;
+	Shapes.Emplace(MoveTemp(Shape));
+	Body_External.SetShapesArray(MoveTemp(Shapes));
+
+	BodyInstance.PhysicsUserData = FPhysicsUserData(&BodyInstance);
+	BodyInstance.OwnerComponent = this;
+	BodyInstance.ActorHandle = PhysHandle;
+
+	Body_External.SetUserData(&BodyInstance.PhysicsUserData);
+
+	TArray<FPhysicsActorHandle> Actors;
+	Actors.Add(PhysHandle);
+
+	FPhysicsCommand::ExecuteWrite(PhysScene, [&]()
+	{
+		const bool bImmediateAccelStructureInsertion = true;
+		PhysScene->AddActorsToScene_AssumesLocked(Actors, bImmediateAccelStructureInsertion);
+	});
+
+	PhysScene->AddToComponentMaps(this, PhysHandle);
+}
+
+void UGeoClipmapHeightfieldComponent::OnDestroyPhysicsState()
+{
+	if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		FPhysicsActorHandle& ActorHandle = BodyInstance.GetPhysicsActorHandle();
+		if (FPhysicsInterface::IsValid(ActorHandle))
+		{
+			PhysScene->RemoveFromComponentMaps(ActorHandle);
+		}
+	}
+
+	// Terminates BodyInstance
+	Super::OnDestroyPhysicsState();
+}
@@ -19,6 +19,11 @@
 #include "DynamicMeshBuilder.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 #include "StaticMeshResources.h"
+#include "Component/GeoClipmapRingGeometry.h"
+#include "GeoClipmapMeshRenderData.h"
+#include "PrimitiveUniformShaderParametersBuilder.h"
+#include "Containers/LockFreeList.h"
+#include "Async/ParallelFor.h"
 //#include "RayTracingDefinitions.h"
 //#include "RayTracingInstance.h"
 
@@ -28,14 +33,59 @@ DECLARE_CYCLE_STAT(TEXT("UpdateSection GeoClip GT"), STAT_GeoClipProcMesh_Update
 DECLARE_CYCLE_STAT(TEXT("UpdateSection GeoClip RT"), STAT_GeoClipProcMesh_UpdateSectionRT, STATGROUP_GeoClipProceduralMesh);
 DECLARE_CYCLE_STAT(TEXT("Get GeoClip ProcMesh Elements"), STAT_GeoClipProcMesh_GetMeshElements, STATGROUP_GeoClipProceduralMesh);
 DECLARE_CYCLE_STAT(TEXT("Update GeoClip Collision"), STAT_GeoClipProcMesh_UpdateCollision, STATGROUP_GeoClipProceduralMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GeoClip Primitive Uniform Buffers"), STAT_GeoClipProcMesh_PrimitiveUniformBuffers, STATGROUP_GeoClipProceduralMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GeoClip Culled Blocks"), STAT_GeoClipProcMesh_CulledBlocks, STATGROUP_GeoClipProceduralMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GeoClip Static Sections"), STAT_GeoClipProcMesh_StaticSections, STATGROUP_GeoClipProceduralMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GeoClip Dynamic Sections"), STAT_GeoClipProcMesh_DynamicSections, STATGROUP_GeoClipProceduralMesh);
 
-DEFINE_LOG_CATEGORY_STATIC(LogGeoClipProceduralComponent, Log, All);
+DEFINE_LOG_CATEGORY(LogGeoClipProceduralComponent);
 
 static TAutoConsoleVariable<int32> CVarRayTracingGeoClipProceduralMesh(
 	TEXT("r.RayTracing.Geometry.GeoClipProceduralMeshes"),
 	1,
 	TEXT("Include GeoClip procedural meshes in ray tracing effects (default = 1 (procedural meshes enabled in ray tracing))"));
 
+static TAutoConsoleVariable<int32> CVarGeoClipProceduralMeshStaticDraw(
+	TEXT("r.GeoClipProceduralMesh.StaticDraw"),
+	1,
+	TEXT("Draw GeoClip procedural mesh sections from cached mesh draw commands instead of every frame through GetDynamicMeshElements. Read when scene proxies are created"));
+
+static TAutoConsoleVariable<int32> CVarGeoClipProceduralMeshBlockCulling(
+	TEXT("r.GeoClipProceduralMesh.BlockCulling"),
+	0,
+	TEXT("Frustum cull the blocks of GeoClip procedural mesh sections against each view (default = 0). Sections with blocks are then drawn dynamically every frame instead of from cached mesh draw commands, trading draw setup cost for fewer triangles. Read when scene proxies are created"));
+
+/** Fraction of the levels extent added to the component bounds, so moving levels rarely update them */
+static constexpr float GeoClipmapLevelBoundsSlack = 0.25f;
+
+/** Changed vertices this close to the previous dirty range extend it, instead of costing one more buffer lock */
+static constexpr int32 GeoClipmapDirtyRangeMergeDistance = 64;
+
+static void AddGeoClipmapDirtyVertex(TArray<FGeoClipmapVertexRange>& DirtyRanges, int32 VertexIndex)
+{
+	if (DirtyRanges.Num() > 0 && VertexIndex - (DirtyRanges.Last().FirstVertex + DirtyRanges.Last().NumVertices) <= GeoClipmapDirtyRangeMergeDistance)
+	{
+		DirtyRanges.Last().NumVertices = VertexIndex - DirtyRanges.Last().FirstVertex + 1;
+	}
+	else
+	{
+		DirtyRanges.Add({ VertexIndex, 1 });
+	}
+}
+
+/** Every vertex of [FirstVertex, LastVertex] is dirty, ranges must be added in increasing order */
+static void AddGeoClipmapDirtyRange(TArray<FGeoClipmapVertexRange>& DirtyRanges, int32 FirstVertex, int32 LastVertex)
+{
+	if (DirtyRanges.Num() > 0 && FirstVertex - (DirtyRanges.Last().FirstVertex + DirtyRanges.Last().NumVertices) <= GeoClipmapDirtyRangeMergeDistance)
+	{
+		DirtyRanges.Last().NumVertices = LastVertex - DirtyRanges.Last().FirstVertex + 1;
+	}
+	else
+	{
+		DirtyRanges.Add({ FirstVertex, LastVertex - FirstVertex + 1 });
+	}
+}
+
 
 #if 0
 void UGeoClipmapMeshComponent::SetLocalBound(FBoxSphereBounds NewBound)
@@ -122,56 +172,123 @@ private:
 	uint32 Size;
 };
 
+/** Part of a section culled on its own */
+struct FProcMeshProxyBlock
+{
+	int32 FirstIndex;
+	int32 NumPrimitives;
+	int32 MinVertexIndex;
+	int32 MaxVertexIndex;
+	/** Bounds in the space of the section, before its level transform */
+	FBoxSphereBounds LocalBounds;
+};
+
 /** Class representing a single section of the proc mesh */
 class FProcMeshProxySection
 {
 public:
 	/** Material applied to this section */
 	UMaterialInterface* Material;
-	/** Vertex buffer for this section */
-	FStaticMeshVertexBuffers VertexBuffers;
-	/** Index buffer for this section */
-	FDynamicMeshIndexBuffer32 IndexBuffer;
-	/** Vertex factory for this section */
-	FLocalVertexFactory VertexFactory;
+	/** Buffers and vertex factory for this section, owned or shared */
+	FGeoClipmapSectionRenderData* RenderData;
+	/** Keeps the buffers of an owned section alive as long as this section uses them, they outlive the proxy */
+	FGeoClipmapSectionRenderCachePtr RenderCache;
+	/** Keeps shared buffers alive as long as this section uses them */
+	FGeoClipmapSharedSectionPtr SharedSection;
+	/** Indices of RenderData drawn by this section, sections sharing buffers draw different ranges of them */
+	int32 FirstIndex;
+	int32 NumPrimitives;
+	/** Vertex the indices of the section, and of its blocks, are relative to */
+	int32 BaseVertexIndex;
+	int32 MinVertexIndex;
+	int32 MaxVertexIndex;
+	/** Level of the proxy this section is drawn with, INDEX_NONE for none */
+	int32 LevelIndex;
 	/** Whether this section is currently visible */
 	bool bSectionVisible;
+	/** Drawn from cached mesh draw commands instead of GetDynamicMeshElements */
+	bool bStaticDraw;
+	/** Consecutive parts of the section culled against each view, empty to draw it whole */
+	TArray<FProcMeshProxyBlock> Blocks;
 
 #if RHI_RAYTRACING
 	FRayTracingGeometry RayTracingGeometry;
 #endif
 
-	FProcMeshProxySection(ERHIFeatureLevel::Type InFeatureLevel)
+	FProcMeshProxySection()
 	: Material(NULL)
-	, VertexFactory(InFeatureLevel, "FProcMeshProxySection")
+	, RenderData(nullptr)
+	, FirstIndex(0)
+	, NumPrimitives(0)
+	, BaseVertexIndex(0)
+	, MinVertexIndex(0)
+	, MaxVertexIndex(0)
+	, LevelIndex(INDEX_NONE)
 	, bSectionVisible(true)
+	, bStaticDraw(false)
 	{}
 };
 
 /** 
  *	Struct used to send update to mesh data 
- *	Arrays may be empty, in which case no update is performed.
+ *	Recycled through a pool: the game thread fills a packet while the render thread uploads the previous one, only ownership goes through the render command.
  */
 class FGeoCProcMeshSectionUpdateData
 {
 public:
-	/** Section to update */
-	int32 TargetSection;
-	/** New vertex information */
-	TArray<FGeoCProcMeshVertex> NewVertexBuffer;
+	/** New vertices of the dirty ranges, in the formats of the section buffers */
+	FGeoClipmapVertexUpdate Vertices;
+
+	/** Game thread, take a packet from the pool, or allocate one when every pooled packet is in flight */
+	static FGeoCProcMeshSectionUpdateData* Acquire()
+	{
+		FGeoCProcMeshSectionUpdateData* Data = Pool.Pop();
+		if (Data)
+		{
+			NumPooled.Decrement();
+			return Data;
+		}
+		return new FGeoCProcMeshSectionUpdateData;
+	}
+
+	/** Render thread, give a packet back once uploaded. Its arrays keep their allocations for the next update */
+	static void Release(FGeoCProcMeshSectionUpdateData* Data)
+	{
+		if (NumPooled.Increment() <= MaxPooled)
+		{
+			Pool.Push(Data);
+		}
+		else
+		{
+			NumPooled.Decrement();
+			delete Data;
+		}
+	}
+
+private:
+	/** Enough for a few sections updated every frame, larger bursts allocate */
+	static constexpr int32 MaxPooled = 16;
+
+	static TLockFreePointerListUnordered<FGeoCProcMeshSectionUpdateData, PLATFORM_CACHE_LINE_SIZE> Pool;
+	static FThreadSafeCounter NumPooled;
 };
 
-static void ConvertProcMeshToDynMeshVertex(FDynamicMeshVertex& Vert, const FGeoCProcMeshVertex& ProcVert)
+TLockFreePointerListUnordered<FGeoCProcMeshSectionUpdateData, PLATFORM_CACHE_LINE_SIZE> FGeoCProcMeshSectionUpdateData::Pool;
+FThreadSafeCounter FGeoCProcMeshSectionUpdateData::NumPooled;
+
+/** Game thread, send new vertices to the buffers of a section, whether or not a proxy is drawing them */
+static void EnqueueGeoClipmapSectionUpdate(const FGeoClipmapSectionRenderCachePtr& RenderCache, FGeoCProcMeshSectionUpdateData* SectionData)
 {
-	Vert.Position = FVector3f(ProcVert.Position);
-	Vert.Color = ProcVert.Color;
-	Vert.TextureCoordinate[0] = FVector2f(ProcVert.UV0);
-	Vert.TextureCoordinate[1] = FVector2f(ProcVert.UV1);
-	Vert.TextureCoordinate[2] = FVector2f(ProcVert.UV2);
-	Vert.TextureCoordinate[3] = FVector2f(ProcVert.UV3);
-	Vert.TangentX = ProcVert.Tangent.TangentX;
-	Vert.TangentZ = ProcVert.Normal;
-	Vert.TangentZ.Vector.W = ProcVert.Tangent.bFlipTangentY ? -127 : 127;
+	ENQUEUE_RENDER_COMMAND(FGeoCProcMeshSectionUpdate)
+	([RenderCache, SectionData](FRHICommandListImmediate& RHICmdList)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GeoClipProcMesh_UpdateSectionRT);
+
+		RenderCache->GetRenderData()->UpdateVertices_RenderThread(SectionData->Vertices);
+
+		// Recycle data sent from game thread
+		FGeoCProcMeshSectionUpdateData::Release(SectionData);
+	});
 }
 
 /** Procedural mesh scene proxy */
@@ -188,43 +305,58 @@ public:
 		: FPrimitiveSceneProxy(Component)
 		, BodySetup(Component->GetBodySetup())
 		, MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+		, bHasCustomOcclusionBounds(true)
+		, OcclusionBounds(Component->OcclusionLocalBounds)
 	{
+		// Copy each level
+		for (const FGeoClipmapLevel& Level : Component->Levels)
+		{
+			LevelToLocal.Add(Level.GetLevelToLocal());
+			LevelLocalBounds.Add(Level.SectionsBox.IsValid ? FBoxSphereBounds(Level.SectionsBox) : FBoxSphereBounds(ForceInit));
+		}
+
+		// With GPU Scene, vertex factories supporting it would read the primitive transform from the scene and ignore the level uniform buffers
+		const bool bAllowStaticDraw = CVarGeoClipProceduralMeshStaticDraw.GetValueOnGameThread() != 0;
+		const bool bUseGPUScene = UseGPUScene(GetScene().GetShaderPlatform(), GetScene().GetFeatureLevel());
+		const bool bBlockCulling = CVarGeoClipProceduralMeshBlockCulling.GetValueOnGameThread() != 0;
+
+		// New owned buffers are filled in parallel once every section is created
+		TArray<TPair<FGeoClipmapSectionRenderCache*, const FGeoCProcMeshSection*>, TInlineAllocator<8>> RenderCachesToFill;
+
 		// Copy each section
 		const int32 NumSections = Component->ProcMeshSections.Num();
 		Sections.AddZeroed(NumSections);
 		for (int SectionIdx = 0; SectionIdx < NumSections; SectionIdx++)
 		{
 			FGeoCProcMeshSection& SrcSection = Component->ProcMeshSections[SectionIdx];
-			if (SrcSection.ProcIndexBuffer.Num() > 0 && SrcSection.ProcVertexBuffer.Num() > 0)
+			if (SrcSection.GetNumIndices() > 0 && SrcSection.GetNumVertices() > 0)
 			{
-				FProcMeshProxySection* NewSection = new FProcMeshProxySection(GetScene().GetFeatureLevel());
+				FProcMeshProxySection* NewSection = new FProcMeshProxySection();
 
-				// Copy data from vertex buffer
-				const int32 NumVerts = SrcSection.ProcVertexBuffer.Num();
-
-				// Allocate verts
-
-				TArray<FDynamicMeshVertex> Vertices;
-				Vertices.SetNumUninitialized(NumVerts);
-				// Copy verts
-				for (int VertIdx = 0; VertIdx < NumVerts; VertIdx++)
+				if (SrcSection.SharedSection.IsValid())
 				{
-					const FGeoCProcMeshVertex& ProcVert = SrcSection.ProcVertexBuffer[VertIdx];
-					FDynamicMeshVertex& Vert = Vertices[VertIdx];
-					ConvertProcMeshToDynMeshVertex(Vert, ProcVert);
+					// Reuse the buffers every other level/world referencing this geometry already uploaded
+					NewSection->SharedSection = SrcSection.SharedSection;
+					NewSection->RenderData = SrcSection.SharedSection->GetOrCreateRenderData(GetScene().GetFeatureLevel());
+				}
+				else
+				{
+					// Buffers of a previous proxy are reused as long as the section content did not change
+					if (!SrcSection.RenderCache.IsValid() || SrcSection.RenderCache->GetFeatureLevel() != GetScene().GetFeatureLevel())
+					{
+						SrcSection.RenderCache = MakeShared<FGeoClipmapSectionRenderCache, ESPMode::ThreadSafe>(GetScene().GetFeatureLevel());
+						RenderCachesToFill.Emplace(SrcSection.RenderCache.Get(), &SrcSection);
+					}
+					NewSection->RenderCache = SrcSection.RenderCache;
+					NewSection->RenderData = SrcSection.RenderCache->GetRenderData();
 				}
 
-				// Copy index buffer
-				NewSection->IndexBuffer.Indices = SrcSection.ProcIndexBuffer;
-
-				NewSection->VertexBuffers.InitFromDynamicVertex(&NewSection->VertexFactory, Vertices, 4);
-
-				// Enqueue initialization of render resource
-				BeginInitResource(&NewSection->VertexBuffers.PositionVertexBuffer);
-				BeginInitResource(&NewSection->VertexBuffers.StaticMeshVertexBuffer);
-				BeginInitResource(&NewSection->VertexBuffers.ColorVertexBuffer);
-				BeginInitResource(&NewSection->IndexBuffer);
-				BeginInitResource(&NewSection->VertexFactory);
+				const FGeoClipmapIndexRange Range = SrcSection.GetIndexRange();
+				NewSection->FirstIndex = Range.FirstIndex;
+				NewSection->NumPrimitives = Range.NumIndices / 3;
+				NewSection->BaseVertexIndex = Range.BaseVertexIndex;
+				NewSection->MinVertexIndex = Range.MinVertexIndex;
+				NewSection->MaxVertexIndex = Range.MaxVertexIndex;
 
 				// Grab material
 				NewSection->Material = Component->GetMaterial(SectionIdx);
@@ -235,12 +367,60 @@ public:
 
 				// Copy visibility info
 				NewSection->bSectionVisible = SrcSection.bSectionVisible;
+				NewSection->LevelIndex = LevelToLocal.IsValidIndex(SrcSection.LevelIndex) ? SrcSection.LevelIndex : INDEX_NONE;
+
+				if (bBlockCulling)
+				{
+					for (const FGeoClipmapIndexRange& SrcBlock : SrcSection.SharedBlocks)
+					{
+						FProcMeshProxyBlock& Block = NewSection->Blocks.AddDefaulted_GetRef();
+						Block.FirstIndex = SrcBlock.FirstIndex;
+						Block.NumPrimitives = SrcBlock.NumIndices / 3;
+						Block.MinVertexIndex = SrcBlock.MinVertexIndex;
+						Block.MaxVertexIndex = SrcBlock.MaxVertexIndex;
+						Block.LocalBounds = FBoxSphereBounds(SrcBlock.LocalBox);
+					}
+				}
 
 				// Save ref to new section
 				Sections[SectionIdx] = NewSection;
+			}
+		}
+
+		// Sections write their final streams directly, with no intermediate vertex array
+		ParallelFor(RenderCachesToFill.Num(), [&RenderCachesToFill](int32 FillIdx)
+		{
+			RenderCachesToFill[FillIdx].Key->GetRenderData()->FillFromSection(*RenderCachesToFill[FillIdx].Value);
+		}, RenderCachesToFill.Num() <= 1);
+
+		// Resources are initialized from the game thread, in section order
+		for (const TPair<FGeoClipmapSectionRenderCache*, const FGeoCProcMeshSection*>& RenderCache : RenderCachesToFill)
+		{
+			RenderCache.Key->BeginInitResources();
+		}
+
+		for (FProcMeshProxySection* NewSection : Sections)
+		{
+			if (NewSection != nullptr)
+			{
+				// Cached mesh draw commands can not be culled per block, sections only have blocks when block culling is on.
+				// None of the clipmap vertex factories support the primitive id stream, the check keeps a level from being drawn with the component transform
+				NewSection->bStaticDraw = bAllowStaticDraw && NewSection->Blocks.Num() == 0 && (NewSection->LevelIndex == INDEX_NONE || !bUseGPUScene || !NewSection->RenderData->GetVertexFactory()->GetType()->SupportsPrimitiveIdStream());
+				bHasStaticSections |= NewSection->bStaticDraw;
+				bHasDynamicSections |= !NewSection->bStaticDraw;
+
+				if (NewSection->bStaticDraw)
+				{
+					INC_DWORD_STAT(STAT_GeoClipProcMesh_StaticSections);
+				}
+				else
+				{
+					INC_DWORD_STAT(STAT_GeoClipProcMesh_DynamicSections);
+				}
 
 #if RHI_RAYTRACING
-				if (IsRayTracingEnabled())
+				// Compact sections have no position stream to build ray tracing geometry from
+				if (IsRayTracingEnabled() && NewSection->RenderData->HasPositionVertexBuffer())
 				{
 					ENQUEUE_RENDER_COMMAND(InitProceduralMeshRayTracingGeometry)(
 						[this, DebugName = Component->GetFName(), NewSection](FRHICommandListImmediate& RHICmdList)
@@ -256,11 +436,13 @@ public:
 						NewSection->RayTracingGeometry.SetInitializer(Initializer);
 						NewSection->RayTracingGeometry.InitResource();
 
-						NewSection->RayTracingGeometry.Initializer.IndexBuffer = NewSection->IndexBuffer.IndexBufferRHI;
-						NewSection->RayTracingGeometry.Initializer.TotalPrimitiveCount = NewSection->IndexBuffer.Indices.Num() / 3;
+						NewSection->RayTracingGeometry.Initializer.IndexBuffer = NewSection->RenderData->GetIndexBuffer().IndexBufferRHI;
+						NewSection->RayTracingGeometry.Initializer.TotalPrimitiveCount = NewSection->NumPrimitives;
 
 						FRayTracingGeometrySegment Segment;
-						Segment.VertexBuffer = NewSection->VertexBuffers.PositionVertexBuffer.VertexBufferRHI;
+						Segment.VertexBuffer = NewSection->RenderData->PositionVertexBuffer.VertexBufferRHI;
+						Segment.VertexBufferOffset = NewSection->BaseVertexIndex * Segment.VertexBufferStride;
+						Segment.FirstPrimitive = NewSection->FirstIndex / 3;
 						Segment.NumPrimitives = NewSection->RayTracingGeometry.Initializer.TotalPrimitiveCount;
 						Segment.MaxVertices = Segment.VertexBuffer->GetSize();
 						NewSection->RayTracingGeometry.Initializer.Segments.Add(Segment);
@@ -281,12 +463,16 @@ public:
 		{
 			if (Section != nullptr)
 			{
-				Section->VertexBuffers.PositionVertexBuffer.ReleaseResource();
-				Section->VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
-				Section->VertexBuffers.ColorVertexBuffer.ReleaseResource();
-				Section->IndexBuffer.ReleaseResource();
-				Section->VertexFactory.ReleaseResource();
+				if (Section->bStaticDraw)
+				{
+					DEC_DWORD_STAT(STAT_GeoClipProcMesh_StaticSections);
+				}
+				else
+				{
+					DEC_DWORD_STAT(STAT_GeoClipProcMesh_DynamicSections);
+				}
 
+				// Owned and shared buffers are released along with their last reference, not with the proxy
 #if RHI_RAYTRACING
 				if (IsRayTracingEnabled())
 				{
@@ -308,108 +494,123 @@ public:
 		bHasCustomOcclusionBounds = true;
 	}
 
-	/** Called on render thread to assign new dynamic data */
-	void UpdateSection_RenderThread(FGeoCProcMeshSectionUpdateData* SectionData)
+	/** Called on render thread to assign new bounds to the blocks of a section and to its level */
+	void UpdateSectionBounds_RenderThread(int32 SectionIndex, TArray<FBoxSphereBounds>&& BlockBounds, int32 LevelIndex, const FBoxSphereBounds& LevelBounds)
 	{
-		SCOPE_CYCLE_COUNTER(STAT_GeoClipProcMesh_UpdateSectionRT);
-
 		check(IsInRenderingThread());
 
-		// Check we have data 
-		if(	SectionData != nullptr) 			
+		// Blocks are missing when block culling is disabled
+		if (SectionIndex < Sections.Num() &&
+			Sections[SectionIndex] != nullptr &&
+			Sections[SectionIndex]->Blocks.Num() == BlockBounds.Num())
 		{
-			// Check it references a valid section
-			if (SectionData->TargetSection < Sections.Num() &&
-				Sections[SectionData->TargetSection] != nullptr)
+			for (int32 BlockIdx = 0; BlockIdx < BlockBounds.Num(); BlockIdx++)
 			{
-				FProcMeshProxySection* Section = Sections[SectionData->TargetSection];
+				Sections[SectionIndex]->Blocks[BlockIdx].LocalBounds = BlockBounds[BlockIdx];
+			}
+		}
 
-				// Lock vertex buffer
-				const int32 NumVerts = SectionData->NewVertexBuffer.Num();
-			
-				// Iterate through vertex data, copying in new info
-				for(int32 i=0; i<NumVerts; i++)
-				{
-					const FGeoCProcMeshVertex& ProcVert = SectionData->NewVertexBuffer[i];
-					FDynamicMeshVertex Vertex;
-					ConvertProcMeshToDynMeshVertex(Vertex, ProcVert);
-
-					Section->VertexBuffers.PositionVertexBuffer.VertexPosition(i) = Vertex.Position;
-					Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(i, FVector3f(Vertex.TangentX.ToFVector()), Vertex.GetTangentY(), FVector3f(Vertex.TangentZ.ToFVector()));
-					Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 0, Vertex.TextureCoordinate[0]);
-					Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 1, Vertex.TextureCoordinate[1]);
-					Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 2, Vertex.TextureCoordinate[2]);
-					Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 3, Vertex.TextureCoordinate[3]);
-					Section->VertexBuffers.ColorVertexBuffer.VertexColor(i) = Vertex.Color;
-				}
+		if (LevelLocalBounds.IsValidIndex(LevelIndex))
+		{
+			LevelLocalBounds[LevelIndex] = LevelBounds;
 
-				{
-					auto& VertexBuffer = Section->VertexBuffers.PositionVertexBuffer;
-					void* VertexBufferData = RHILockVertexBuffer(VertexBuffer.VertexBufferRHI, 0, VertexBuffer.GetNumVertices() * VertexBuffer.GetStride(), RLM_WriteOnly);
-					FMemory::Memcpy(VertexBufferData, VertexBuffer.GetVertexData(), VertexBuffer.GetNumVertices() * VertexBuffer.GetStride());
-					RHIUnlockVertexBuffer(VertexBuffer.VertexBufferRHI);
-				}
+			if (LevelUniformBuffers.IsValidIndex(LevelIndex))
+			{
+				UpdateLevelUniformBuffer_RenderThread(LevelIndex);
+			}
+		}
+	}
 
-				{
-					auto& VertexBuffer = Section->VertexBuffers.ColorVertexBuffer;
-					void* VertexBufferData = RHILockVertexBuffer(VertexBuffer.VertexBufferRHI, 0, VertexBuffer.GetNumVertices() * VertexBuffer.GetStride(), RLM_WriteOnly);
-					FMemory::Memcpy(VertexBufferData, VertexBuffer.GetVertexData(), VertexBuffer.GetNumVertices() * VertexBuffer.GetStride());
-					RHIUnlockVertexBuffer(VertexBuffer.VertexBufferRHI);
-				}
+	/** Called on render thread with the visibility of every section, once per frame at most */
+	void SetSectionsVisibility_RenderThread(const TBitArray<>& Visibility)
+	{
+		check(IsInRenderingThread());
 
-				{
-					auto& VertexBuffer = Section->VertexBuffers.StaticMeshVertexBuffer;
-					void* VertexBufferData = RHILockVertexBuffer(VertexBuffer.TangentsVertexBuffer.VertexBufferRHI, 0, VertexBuffer.GetTangentSize(), RLM_WriteOnly);
-					FMemory::Memcpy(VertexBufferData, VertexBuffer.GetTangentData(), VertexBuffer.GetTangentSize());
-					RHIUnlockVertexBuffer(VertexBuffer.TangentsVertexBuffer.VertexBufferRHI);
-				}
+		bool bStaticSectionChanged = false;
 
-				{
-					auto& VertexBuffer = Section->VertexBuffers.StaticMeshVertexBuffer;
-					void* VertexBufferData = RHILockVertexBuffer(VertexBuffer.TexCoordVertexBuffer.VertexBufferRHI, 0, VertexBuffer.GetTexCoordSize(), RLM_WriteOnly);
-					FMemory::Memcpy(VertexBufferData, VertexBuffer.GetTexCoordData(), VertexBuffer.GetTexCoordSize());
-					RHIUnlockVertexBuffer(VertexBuffer.TexCoordVertexBuffer.VertexBufferRHI);
-				}
+		const int32 NumSections = FMath::Min(Sections.Num(), Visibility.Num());
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			FProcMeshProxySection* Section = Sections[SectionIndex];
+			if (Section != nullptr && Section->bSectionVisible != Visibility[SectionIndex])
+			{
+				Section->bSectionVisible = Visibility[SectionIndex];
+				bStaticSectionChanged |= Section->bStaticDraw;
 			}
+		}
 
-			// Free data sent from game thread
-			delete SectionData;
+		// Static sections are only drawn when cached, recache them once for every change
+		if (bStaticSectionChanged)
+		{
+			GetScene().UpdateCachedRenderStates(this);
 		}
 	}
 
-	void SetSectionVisibility_RenderThread(int32 SectionIndex, bool bNewVisibility)
+	void SetLevelTransform_RenderThread(int32 LevelIndex, const FMatrix& NewLevelToLocal)
 	{
 		check(IsInRenderingThread());
 
-		if(	SectionIndex < Sections.Num() &&
-			Sections[SectionIndex] != nullptr)
+		if (LevelToLocal.IsValidIndex(LevelIndex))
 		{
-			Sections[SectionIndex]->bSectionVisible = bNewVisibility;
+			LevelToLocal[LevelIndex] = NewLevelToLocal;
+
+			if (LevelUniformBuffers.IsValidIndex(LevelIndex))
+			{
+				UpdateLevelUniformBuffer_RenderThread(LevelIndex);
+			}
 		}
 	}
 
 
-#if 0
-	bool GetStaticMeshElement(FProcMeshProxySection* Section,int32 LODIndex, bool bForToolMesh, bool bForcedLOD, UMaterialInterface* InMaterialInterface, FMeshBatch& MeshBatch) const
+	/** Render thread, create or update the primitive uniform buffer the static sections of a level are drawn with */
+	void UpdateLevelUniformBuffer_RenderThread(int32 LevelIndex)
 	{
-		UMaterialInterface* MaterialInterface = nullptr;
-
-
-		int32 MaterialIndex = 0;
-
-		// Defaults to the material interface w/ potential tessellation
-		MaterialInterface = InMaterialInterface;
+		const FMatrix LevelLocalToWorld = LevelToLocal[LevelIndex] * GetLocalToWorld();
+		const FBoxSphereBounds& LocalBounds = LevelLocalBounds[LevelIndex];
+		const FBoxSphereBounds WorldBounds = LocalBounds.TransformBy(LevelLocalToWorld);
+
+		// The terrain does not move when a level snaps, there is no velocity to output
+		const FPrimitiveUniformShaderParameters Parameters = FPrimitiveUniformShaderParametersBuilder{}
+			.Defaults()
+			.LocalToWorld(LevelLocalToWorld)
+			.PreviousLocalToWorld(LevelLocalToWorld)
+			.ActorWorldPosition(WorldBounds.Origin)
+			.WorldBounds(WorldBounds)
+			.LocalBounds(LocalBounds)
+			.PreSkinnedLocalBounds(LocalBounds)
+			.ReceivesDecals(ReceivesDecals())
+			.Build();
+
+		// Updated in place, cached mesh draw commands keep referencing the same buffer
+		if (LevelUniformBuffers[LevelIndex].IsValid())
+		{
+			LevelUniformBuffers[LevelIndex].UpdateUniformBufferImmediate(Parameters);
+		}
+		else
+		{
+			LevelUniformBuffers[LevelIndex] = TUniformBufferRef<FPrimitiveUniformShaderParameters>::CreateUniformBufferImmediate(Parameters, UniformBuffer_MultiFrame);
+		}
+	}
 
-		if (!MaterialInterface)
+	virtual void OnTransformChanged() override
+	{
+		if (!bHasStaticSections)
 		{
-			return false;
+			return;
 		}
 
+		LevelUniformBuffers.SetNum(LevelToLocal.Num());
+		for (int32 LevelIndex = 0; LevelIndex < LevelToLocal.Num(); LevelIndex++)
+		{
+			UpdateLevelUniformBuffer_RenderThread(LevelIndex);
+		}
+	}
 
-		MeshBatch.VertexFactory = &Section->VertexFactory;
-		MeshBatch.MaterialRenderProxy = MaterialInterface->GetRenderProxy();
+	void GetStaticMeshElement(const FProcMeshProxySection* Section, FMeshBatch& MeshBatch) const
+	{
+		MeshBatch.VertexFactory = Section->RenderData->GetVertexFactory();
+		MeshBatch.MaterialRenderProxy = Section->Material->GetRenderProxy();
 
-		//MeshBatch.LCI = ComponentLightInfo.Get();
 		MeshBatch.ReverseCulling = IsLocalToWorldDeterminantNegative();
 		MeshBatch.CastShadow = true;
 		MeshBatch.CastRayTracedShadow = true;
@@ -422,69 +623,48 @@ public:
 		MeshBatch.LODIndex = 0;
 		MeshBatch.bDitheredLODTransition = false;
 
-		// Combined batch element
 		FMeshBatchElement& BatchElement = MeshBatch.Elements[0];
 
-		//BatchElement.UserData = BatchElementParams;
-		BatchElement.PrimitiveUniformBuffer = GetUniformBuffer();
-		BatchElement.IndexBuffer = &Section->IndexBuffer;
-				
-		BatchElement.NumPrimitives = Section->IndexBuffer.Indices.Num() / 3;
-		BatchElement.FirstIndex = 0;
-		BatchElement.MinVertexIndex = 0;
-		BatchElement.MaxVertexIndex = Section->VertexBuffers.PositionVertexBuffer.GetNumVertices() - 1;
-
-
-		return true;
-	}
-
-
-
-	virtual int32 GetNumMeshBatches() const
-	{
-		int Batchc = 0;
-		for (const FProcMeshProxySection* Section : Sections)
-			if (Section != nullptr && Section->bSectionVisible && Section->Material)
-				Batchc++;
+		// Sections of a level read their transform from the level buffer, none of the clipmap vertex factories read it from GPU Scene
+		BatchElement.PrimitiveUniformBuffer = Section->LevelIndex != INDEX_NONE ? LevelUniformBuffers[Section->LevelIndex].GetReference() : GetUniformBuffer();
+		BatchElement.IndexBuffer = &Section->RenderData->GetIndexBuffer();
 
-		return Batchc;
+		BatchElement.NumPrimitives = Section->NumPrimitives;
+		BatchElement.FirstIndex = Section->FirstIndex;
+		BatchElement.BaseVertexIndex = Section->BaseVertexIndex;
+		BatchElement.MinVertexIndex = Section->MinVertexIndex;
+		BatchElement.MaxVertexIndex = Section->MaxVertexIndex;
 	}
 
 	virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override
 	{
 		checkSlow(IsInParallelRenderingThread());
-		if (!HasViewDependentDPG())
+		if (HasViewDependentDPG())
 		{
-		
-			if (Sections.Num() == 0 || !Sections[0]->Material )
+			return;
+		}
+
+		int32 NumBatches = 0;
+		for (const FProcMeshProxySection* Section : Sections)
+		{
+			if (Section != nullptr && Section->bStaticDraw && Section->bSectionVisible)
 			{
-				return;
+				NumBatches++;
 			}
+		}
+		PDI->ReserveMemoryForMeshes(NumBatches);
 
-
-			const int32 NumBatches = GetNumMeshBatches();
-			PDI->ReserveMemoryForMeshes(NumBatches);
-
-
-			// Iterate over sections
-			for (const FProcMeshProxySection* Section : Sections)
+		// Only visible sections are cached, visibility changes recache the whole proxy
+		for (const FProcMeshProxySection* Section : Sections)
+		{
+			if (Section != nullptr && Section->bStaticDraw && Section->bSectionVisible)
 			{
-				if (Section != nullptr && Section->bSectionVisible && Section->Material)
-				{
-
-					FMeshBatch MeshBatch;
-
-					if (GetStaticMeshElement(const_cast<FProcMeshProxySection*>(Section), 0, false, false, Section->Material, MeshBatch))
-					{
-						PDI->DrawMesh(MeshBatch, FLT_MAX);
-					}
-
-				}
+				FMeshBatch MeshBatch;
+				GetStaticMeshElement(Section, MeshBatch);
+				PDI->DrawMesh(MeshBatch, FLT_MAX);
 			}
 		}
-		
 	}
-#endif
 
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
 	{
@@ -506,47 +686,128 @@ public:
 			Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
 		}
 		*/
+
+		// Every section and view of a level share the same transform, so one buffer per level, plus one for the sections without level
+		bool bHasPrecomputedVolumetricLightmap;
+		FMatrix PreviousLocalToWorld;
+		int32 SingleCaptureIndex;
+		bool bOutputVelocity;
+		GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
+
+		FDynamicPrimitiveUniformBuffer* ComponentUniformBuffer = nullptr;
+		TArray<FDynamicPrimitiveUniformBuffer*, TInlineAllocator<16>> DynamicLevelUniformBuffers;
+		DynamicLevelUniformBuffers.SetNumZeroed(LevelToLocal.Num());
+
+		auto GetSectionUniformBuffer = [&](const FProcMeshProxySection* Section) -> FDynamicPrimitiveUniformBuffer*
+		{
+			FDynamicPrimitiveUniformBuffer*& UniformBuffer = Section->LevelIndex != INDEX_NONE ? DynamicLevelUniformBuffers[Section->LevelIndex] : ComponentUniformBuffer;
+			if (!UniformBuffer)
+			{
+				UniformBuffer = &Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+				INC_DWORD_STAT(STAT_GeoClipProcMesh_PrimitiveUniformBuffers);
+
+				if (Section->LevelIndex != INDEX_NONE)
+				{
+					// The terrain does not move when a level snaps, the previous transform uses the current level placement
+					const FMatrix& SectionLevelToLocal = LevelToLocal[Section->LevelIndex];
+					const FMatrix SectionLocalToWorld = SectionLevelToLocal * GetLocalToWorld();
+					const FBoxSphereBounds& SectionLocalBounds = LevelLocalBounds[Section->LevelIndex];
+					UniformBuffer->Set(SectionLocalToWorld, SectionLevelToLocal * PreviousLocalToWorld, SectionLocalBounds.TransformBy(SectionLocalToWorld), SectionLocalBounds, true, bHasPrecomputedVolumetricLightmap, DrawsVelocity(), bOutputVelocity);
+				}
+				else
+				{
+					UniformBuffer->Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(), GetLocalBounds(), true, bHasPrecomputedVolumetricLightmap, DrawsVelocity(), bOutputVelocity);
+				}
+			}
+			return UniformBuffer;
+		};
+
+		auto AddSectionMesh = [&](int32 ViewIndex, const FProcMeshProxySection* Section, int32 FirstIndex, int32 NumPrimitives, int32 MinVertexIndex, int32 MaxVertexIndex)
+		{
+			FMeshBatch& Mesh = Collector.AllocateMesh();
+			FMeshBatchElement& BatchElement = Mesh.Elements[0];
+			BatchElement.IndexBuffer = &Section->RenderData->GetIndexBuffer();
+			Mesh.bWireframe = bWireframe;
+			Mesh.VertexFactory = Section->RenderData->GetVertexFactory();
+			Mesh.MaterialRenderProxy = Section->Material->GetRenderProxy();
+			BatchElement.PrimitiveUniformBufferResource = &GetSectionUniformBuffer(Section)->UniformBuffer;
+
+			BatchElement.FirstIndex = FirstIndex;
+			BatchElement.NumPrimitives = NumPrimitives;
+			BatchElement.BaseVertexIndex = Section->BaseVertexIndex;
+			BatchElement.MinVertexIndex = MinVertexIndex;
+			BatchElement.MaxVertexIndex = MaxVertexIndex;
+			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			Mesh.Type = PT_TriangleList;
+			Mesh.DepthPriorityGroup = SDPG_World;
+			Mesh.bCanApplyViewModeOverrides = true;
+			Mesh.bUseWireframeSelectionColoring = IsSelected();
+			Collector.AddMesh(ViewIndex, Mesh);
+		};
+
 		// Iterate over sections
 		for (const FProcMeshProxySection* Section : Sections)
 		{
-			if (Section != nullptr && Section->bSectionVisible)
+			if (Section != nullptr && Section->bSectionVisible && !Section->bStaticDraw)
 			{
-				FMaterialRenderProxy* MaterialProxy = Section->Material->GetRenderProxy();
+				const FMatrix SectionLocalToWorld = Section->LevelIndex != INDEX_NONE ? LevelToLocal[Section->LevelIndex] * GetLocalToWorld() : GetLocalToWorld();
 
 				// For each view..
 				for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
 				{
 					if (VisibilityMap & (1 << ViewIndex))
 					{
+						if (Section->Blocks.Num() == 0)
+						{
+							AddSectionMesh(ViewIndex, Section, Section->FirstIndex, Section->NumPrimitives, Section->MinVertexIndex, Section->MaxVertexIndex);
+							continue;
+						}
+
+						// Shadow depth views cull against the shadow frustum, in shadow translated space
 						const FSceneView* View = Views[ViewIndex];
-						// Draw the mesh.
-						FMeshBatch& Mesh = Collector.AllocateMesh();
-						FMeshBatchElement& BatchElement = Mesh.Elements[0];
-						BatchElement.IndexBuffer = &Section->IndexBuffer;
-						Mesh.bWireframe = bWireframe;
-						Mesh.VertexFactory = &Section->VertexFactory;
-						Mesh.MaterialRenderProxy = MaterialProxy;
-
-						bool bHasPrecomputedVolumetricLightmap;
-						FMatrix PreviousLocalToWorld;
-						int32 SingleCaptureIndex;
-						bool bOutputVelocity;
-						GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
-
-						FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
-						DynamicPrimitiveUniformBuffer.Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(), GetLocalBounds(), true, bHasPrecomputedVolumetricLightmap, DrawsVelocity(), bOutputVelocity);
-						BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
-
-						BatchElement.FirstIndex = 0;
-						BatchElement.NumPrimitives = Section->IndexBuffer.Indices.Num() / 3;
-						BatchElement.MinVertexIndex = 0;
-						BatchElement.MaxVertexIndex = Section->VertexBuffers.PositionVertexBuffer.GetNumVertices() - 1;
-						Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
-						Mesh.Type = PT_TriangleList;
-						Mesh.DepthPriorityGroup = SDPG_World;
-						Mesh.bCanApplyViewModeOverrides = true;
-						Mesh.bUseWireframeSelectionColoring = IsSelected();
-						Collector.AddMesh(ViewIndex, Mesh);
+						const FConvexVolume* ShadowCullFrustum = View->GetDynamicMeshElementsShadowCullFrustum();
+						const FConvexVolume& CullFrustum = ShadowCullFrustum ? *ShadowCullFrustum : View->ViewFrustum;
+						const FVector CullTranslation = ShadowCullFrustum ? FVector(View->GetPreShadowTranslation()) : FVector::ZeroVector;
+
+						// Visible blocks are consecutive in the index buffer, each run of them is drawn with one batch
+						int32 RunFirstBlock = INDEX_NONE;
+						int32 RunNumPrimitives = 0;
+						int32 RunMinVertexIndex = 0;
+						int32 RunMaxVertexIndex = 0;
+
+						for (int32 BlockIdx = 0; BlockIdx <= Section->Blocks.Num(); BlockIdx++)
+						{
+							bool bBlockVisible = false;
+							if (BlockIdx < Section->Blocks.Num())
+							{
+								const FBoxSphereBounds BlockBounds = Section->Blocks[BlockIdx].LocalBounds.TransformBy(SectionLocalToWorld);
+								bBlockVisible = CullFrustum.IntersectBox(BlockBounds.Origin + CullTranslation, BlockBounds.BoxExtent);
+								if (!bBlockVisible)
+								{
+									INC_DWORD_STAT(STAT_GeoClipProcMesh_CulledBlocks);
+								}
+							}
+
+							if (bBlockVisible)
+							{
+								const FProcMeshProxyBlock& Block = Section->Blocks[BlockIdx];
+								if (RunFirstBlock == INDEX_NONE)
+								{
+									RunFirstBlock = BlockIdx;
+									RunNumPrimitives = 0;
+									RunMinVertexIndex = Block.MinVertexIndex;
+									RunMaxVertexIndex = Block.MaxVertexIndex;
+								}
+								RunNumPrimitives += Block.NumPrimitives;
+								RunMinVertexIndex = FMath::Min(RunMinVertexIndex, Block.MinVertexIndex);
+								RunMaxVertexIndex = FMath::Max(RunMaxVertexIndex, Block.MaxVertexIndex);
+							}
+							else if (RunFirstBlock != INDEX_NONE)
+							{
+								AddSectionMesh(ViewIndex, Section, Section->Blocks[RunFirstBlock].FirstIndex, RunNumPrimitives, RunMinVertexIndex, RunMaxVertexIndex);
+								RunFirstBlock = INDEX_NONE;
+							}
+						}
 					}
 				}
 			}
@@ -579,8 +840,9 @@ public:
 		FPrimitiveViewRelevance Result;
 		Result.bDrawRelevance = IsShown(View);
 		Result.bShadowRelevance = IsShadowCast(View);
-		//Result.bStaticRelevance = true;
-		Result.bDynamicRelevance = true;
+		Result.bStaticRelevance = bHasStaticSections;
+		// Bounds are drawn from GetDynamicMeshElements
+		Result.bDynamicRelevance = bHasDynamicSections || View->Family->EngineShowFlags.Bounds;
 		Result.bRenderInMainPass = ShouldRenderInMainPass();
 		Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
 		Result.bRenderCustomDepth = ShouldRenderCustomDepth();
@@ -594,7 +856,6 @@ public:
 	{
 		return !MaterialRelevance.bDisableDepthTest;
 	}
-#if 0
 	/**
 	*	Returns whether the proxy utilizes custom occlusion bounds or not
 	*
@@ -614,7 +875,6 @@ public:
 	{
 		return CanBeOccluded() ? OcclusionBounds.TransformBy(GetLocalToWorld()) : FPrimitiveSceneProxy::GetCustomOcclusionBounds();
 	}
-#endif
 
 	virtual uint32 GetMemoryFootprint(void) const
 	{
@@ -623,7 +883,7 @@ public:
 
 	uint32 GetAllocatedSize(void) const
 	{
-		return(FPrimitiveSceneProxy::GetAllocatedSize());
+		return(FPrimitiveSceneProxy::GetAllocatedSize() + LevelToLocal.GetAllocatedSize() + LevelLocalBounds.GetAllocatedSize());
 	}
 
 
@@ -655,7 +915,7 @@ public:
 					uint32 SectionIdx = 0;
 					FMeshBatch MeshBatch;
 
-					MeshBatch.VertexFactory = &Section->VertexFactory;
+					MeshBatch.VertexFactory = Section->RenderData->GetVertexFactory();
 					MeshBatch.SegmentIndex = SegmentIndex;
 					MeshBatch.MaterialRenderProxy = Section->Material->GetRenderProxy();
 					MeshBatch.ReverseCulling = IsLocalToWorldDeterminantNegative();
@@ -665,7 +925,7 @@ public:
 					MeshBatch.CastRayTracedShadow = IsShadowCast(Context.ReferenceView);
 
 					FMeshBatchElement& BatchElement = MeshBatch.Elements[0];
-					BatchElement.IndexBuffer = &Section->IndexBuffer;
+					BatchElement.IndexBuffer = &Section->RenderData->GetIndexBuffer();
 
 					bool bHasPrecomputedVolumetricLightmap;
 					FMatrix PreviousLocalToWorld;
@@ -677,10 +937,11 @@ public:
 					DynamicPrimitiveUniformBuffer.Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(), GetLocalBounds(), true, bHasPrecomputedVolumetricLightmap, DrawsVelocity(), bOutputVelocity);
 					BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
 
-					BatchElement.FirstIndex = 0;
-					BatchElement.NumPrimitives = Section->IndexBuffer.Indices.Num() / 3;
-					BatchElement.MinVertexIndex = 0;
-					BatchElement.MaxVertexIndex = Section->VertexBuffers.PositionVertexBuffer.GetNumVertices() - 1;
+					BatchElement.FirstIndex = Section->FirstIndex;
+					BatchElement.NumPrimitives = Section->NumPrimitives;
+					BatchElement.BaseVertexIndex = Section->BaseVertexIndex;
+					BatchElement.MinVertexIndex = Section->MinVertexIndex;
+					BatchElement.MaxVertexIndex = Section->MaxVertexIndex;
 
 					RayTracingInstance.Materials.Add(MeshBatch);
 
@@ -697,6 +958,16 @@ private:
 	/** Array of sections */
 	TArray<FProcMeshProxySection*> Sections;
 
+	/** Scale and offset of each level relative to the component, updated without recreating the proxy */
+	TArray<FMatrix> LevelToLocal;
+	/** Bounds of the sections of each level, in level space */
+	TArray<FBoxSphereBounds> LevelLocalBounds;
+	/** Primitive uniform buffer of each level, only created when some sections are static */
+	TArray<TUniformBufferRef<FPrimitiveUniformShaderParameters>> LevelUniformBuffers;
+
+	bool bHasStaticSections = false;
+	bool bHasDynamicSections = false;
+
 	UBodySetup* BodySetup;
 
 	FMaterialRelevance MaterialRelevance;
@@ -708,6 +979,175 @@ private:
 
 //////////////////////////////////////////////////////////////////////////
 
+const TArray<FGeoCProcMeshVertex>& FGeoCProcMeshSection::GetVertexBuffer() const
+{
+	return SharedSection.IsValid() ? SharedSection->Section.ProcVertexBuffer : ProcVertexBuffer;
+}
+
+int32 FGeoCProcMeshSection::GetNumVertices() const
+{
+	if (SharedSection.IsValid())
+	{
+		return SharedSection->Section.GetNumVertices();
+	}
+
+	if (GridPatches.Num() > 0)
+	{
+		return GridPatches.Last().FirstVertex + GridPatches.Last().GetNumVertices();
+	}
+
+	return CompactVertexBuffer.Num() > 0 ? CompactVertexBuffer.Num() : ProcVertexBuffer.Num();
+}
+
+bool FGeoCProcMeshSection::UsesCompactVertices() const
+{
+	return SharedSection.IsValid() ? SharedSection->Section.UsesCompactVertices() : CompactVertexBuffer.Num() > 0;
+}
+
+bool FGeoCProcMeshSection::UsesBufferlessVertices() const
+{
+	return SharedSection.IsValid() ? SharedSection->Section.UsesBufferlessVertices() : GridPatches.Num() > 0;
+}
+
+int32 FGeoCProcMeshSection::GetNumIndices() const
+{
+	if (SharedSection.IsValid())
+	{
+		return SharedRange.NumIndices;
+	}
+
+	return ProcIndexBuffer16.Num() > 0 ? ProcIndexBuffer16.Num() : ProcIndexBuffer.Num();
+}
+
+uint32 FGeoCProcMeshSection::GetIndex(int32 Index) const
+{
+	if (SharedSection.IsValid())
+	{
+		return SharedRange.BaseVertexIndex + SharedSection->Section.GetIndex(SharedRange.FirstIndex + Index);
+	}
+
+	return ProcIndexBuffer16.Num() > 0 ? ProcIndexBuffer16[Index] : ProcIndexBuffer[Index];
+}
+
+FGeoClipmapIndexRange FGeoCProcMeshSection::GetIndexRange() const
+{
+	if (SharedSection.IsValid())
+	{
+		return SharedRange;
+	}
+
+	FGeoClipmapIndexRange Range;
+	Range.FirstIndex = 0;
+	Range.NumIndices = GetNumIndices();
+	Range.MinVertexIndex = 0;
+	Range.MaxVertexIndex = FMath::Max(GetNumVertices() - 1, 0);
+	Range.LocalBox = SectionLocalBox;
+	return Range;
+}
+
+bool FGeoCProcMeshSection::Uses16BitIndices() const
+{
+	return SharedSection.IsValid() ? SharedSection->Section.Uses16BitIndices() : ProcIndexBuffer16.Num() > 0;
+}
+
+void FGeoCProcMeshSection::SetIndices(const TArray<int32>& Triangles, int32 NumTriIndices, int32 NumVerts)
+{
+	ProcIndexBuffer.Reset();
+	ProcIndexBuffer16.Reset();
+
+	if (NumVerts <= MAX_uint16 + 1)
+	{
+		ProcIndexBuffer16.AddUninitialized(NumTriIndices);
+		for (int32 IndexIdx = 0; IndexIdx < NumTriIndices; IndexIdx++)
+		{
+			ProcIndexBuffer16[IndexIdx] = (uint16)FMath::Min(Triangles[IndexIdx], NumVerts - 1);
+		}
+	}
+	else
+	{
+		ProcIndexBuffer.AddUninitialized(NumTriIndices);
+		for (int32 IndexIdx = 0; IndexIdx < NumTriIndices; IndexIdx++)
+		{
+			ProcIndexBuffer[IndexIdx] = FMath::Min(Triangles[IndexIdx], NumVerts - 1);
+		}
+	}
+}
+
+int32 FGeoCProcMeshSection::GetNumUpdatableVertices() const
+{
+	if (SharedSection.IsValid())
+	{
+		return SharedRange.NumIndices > 0 ? SharedRange.MaxVertexIndex - SharedRange.MinVertexIndex + 1 : 0;
+	}
+
+	return ProcVertexBuffer.Num();
+}
+
+void FGeoCProcMeshSection::DetachSharedSection()
+{
+	if (SharedSection.IsValid())
+	{
+		const FGeoCProcMeshSection& Source = SharedSection->Section;
+		const int32 FirstVertex = SharedRange.BaseVertexIndex + SharedRange.MinVertexIndex;
+		const int32 NumVertices = GetNumUpdatableVertices();
+
+		// Expand to full vertices, the same ones FGeoClipmapVertexFactory builds on the GPU
+		auto ExpandCompactVertex = [&Source](const FGeoClipmapCompactVertex& Compact, FGeoCProcMeshVertex& Vertex)
+		{
+			const float Jitter = Compact.Flags & GeoClipmapVertex_JitterDown ? -Source.CompactVerticalJitter : Source.CompactVerticalJitter;
+			Vertex.Position = FVector(Compact.X, Compact.Y, Jitter);
+			Vertex.Tangent = FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false);
+			Vertex.UV0 = FVector2D(FMath::Frac(Compact.X / 400000.f), FMath::Frac(Compact.Y / 400000.f));
+			Vertex.UV1 = FVector2D(Compact.X, Compact.Y);
+			Vertex.UV2 = FVector2D(Compact.Flags & GeoClipmapVertex_Interior ? 1.f : 0.f, 0.f);
+		};
+
+		// Only the span of vertices the range references, the rest of the shared section belongs to other sections
+		ProcVertexBuffer.SetNum(NumVertices);
+		if (Source.UsesCompactVertices())
+		{
+			for (int32 VertIdx = 0; VertIdx < NumVertices; VertIdx++)
+			{
+				ExpandCompactVertex(Source.CompactVertexBuffer[FirstVertex + VertIdx], ProcVertexBuffer[VertIdx]);
+			}
+		}
+		else if (Source.UsesBufferlessVertices())
+		{
+			for (const FGeoClipmapGridPatch& Patch : Source.GridPatches)
+			{
+				const int32 PatchFirst = FMath::Max(Patch.FirstVertex, FirstVertex);
+				const int32 PatchEnd = FMath::Min(Patch.FirstVertex + Patch.GetNumVertices(), FirstVertex + NumVertices);
+				for (int32 VertIdx = PatchFirst; VertIdx < PatchEnd; VertIdx++)
+				{
+					ExpandCompactVertex(Patch.GetCompactVertex(VertIdx - Patch.FirstVertex), ProcVertexBuffer[VertIdx - FirstVertex]);
+				}
+			}
+		}
+		else
+		{
+			FMemory::Memcpy(ProcVertexBuffer.GetData(), Source.ProcVertexBuffer.GetData() + FirstVertex, NumVertices * sizeof(FGeoCProcMeshVertex));
+		}
+
+		TArray<int32> Triangles;
+		Triangles.SetNumUninitialized(SharedRange.NumIndices);
+		for (int32 IndexIdx = 0; IndexIdx < SharedRange.NumIndices; IndexIdx++)
+		{
+			Triangles[IndexIdx] = (int32)GetIndex(IndexIdx) - FirstVertex;
+		}
+		SetIndices(Triangles, Triangles.Num(), ProcVertexBuffer.Num());
+		SectionLocalBox = SharedRange.LocalBox;
+
+		NumTexCoords = Source.NumTexCoords;
+		bHasVertexColors = Source.bHasVertexColors;
+		bHasTangents = Source.bHasTangents;
+		SharedSection.Reset();
+		SharedRange = FGeoClipmapIndexRange();
+		SharedBlocks.Empty();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 
 UGeoClipmapMeshComponent::UGeoClipmapMeshComponent(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -777,16 +1217,16 @@ void UGeoClipmapMeshComponent::CreateMeshSection(int32 SectionIndex, const TArra
 		NewSection.SectionLocalBox += Vertex.Position;
 	}
 
+	// Only the streams supplied here get GPU buffers
+	NewSection.NumTexCoords = UV3.Num() == NumVerts ? 4 : UV2.Num() == NumVerts ? 3 : UV1.Num() == NumVerts ? 2 : 1;
+	NewSection.bHasVertexColors = VertexColors.Num() == NumVerts;
+	NewSection.bHasTangents = Normals.Num() == NumVerts || Tangents.Num() == NumVerts;
+
 	// Copy index buffer (clamping to vertex range)
 	int32 NumTriIndices = Triangles.Num();
 	NumTriIndices = (NumTriIndices/3) * 3; // Ensure we have exact number of triangles (array is multiple of 3 long)
 
-	NewSection.ProcIndexBuffer.Reset();
-	NewSection.ProcIndexBuffer.AddUninitialized(NumTriIndices);
-	for (int32 IndexIdx = 0; IndexIdx < NumTriIndices; IndexIdx++)
-	{
-		NewSection.ProcIndexBuffer[IndexIdx] = FMath::Min(Triangles[IndexIdx], NumVerts - 1);
-	}
+	NewSection.SetIndices(Triangles, NumTriIndices, NumVerts);
 
 	NewSection.bEnableCollision = bCreateCollision;
 
@@ -795,6 +1235,89 @@ void UGeoClipmapMeshComponent::CreateMeshSection(int32 SectionIndex, const TArra
 	MarkRenderStateDirty(); // New section requires recreating scene proxy
 }
 
+void UGeoClipmapMeshComponent::SetSharedMeshSection(int32 SectionIndex, const FGeoClipmapSharedSectionPtr& SharedSection, const FGeoClipmapIndexRange& Range, TArrayView<const FGeoClipmapIndexRange> Blocks)
+{
+	// Ensure sections array is long enough
+	if (SectionIndex >= ProcMeshSections.Num())
+	{
+		ProcMeshSections.SetNum(SectionIndex + 1, false);
+	}
+
+	FGeoCProcMeshSection& NewSection = ProcMeshSections[SectionIndex];
+	const bool bVisible = NewSection.bSectionVisible;
+	NewSection.Reset();
+	NewSection.bSectionVisible = bVisible;
+
+	if (SharedSection.IsValid())
+	{
+		NewSection.SharedSection = SharedSection;
+		NewSection.SharedRange = Range;
+		if (Range.NumIndices == INDEX_NONE)
+		{
+			NewSection.SharedRange = SharedSection->Section.GetIndexRange();
+		}
+		NewSection.SharedBlocks.Append(Blocks.GetData(), Blocks.Num());
+		NewSection.SectionLocalBox = NewSection.SharedRange.LocalBox;
+	}
+
+	UpdateLocalBounds(); // Update overall bounds
+	MarkRenderStateDirty(); // New section requires recreating scene proxy
+}
+
+int32 UGeoClipmapMeshComponent::AddLevel(const FVector& Offset, const FVector& Scale)
+{
+	FGeoClipmapLevel& NewLevel = Levels.AddDefaulted_GetRef();
+	NewLevel.Offset = Offset;
+	NewLevel.Scale = Scale;
+
+	MarkRenderStateDirty(); // New level requires recreating scene proxy
+	return Levels.Num() - 1;
+}
+
+void UGeoClipmapMeshComponent::SetSectionLevel(int32 SectionIndex, int32 LevelIndex)
+{
+	if (SectionIndex < ProcMeshSections.Num() && LevelIndex < Levels.Num())
+	{
+		ProcMeshSections[SectionIndex].LevelIndex = LevelIndex;
+
+		UpdateLocalBounds(); // Update overall bounds
+		MarkRenderStateDirty(); // Section level is copied by the scene proxy
+	}
+}
+
+void UGeoClipmapMeshComponent::SetLevelTransform(int32 LevelIndex, const FVector& Offset, const FVector& Scale)
+{
+	if (!Levels.IsValidIndex(LevelIndex))
+	{
+		return;
+	}
+
+	FGeoClipmapLevel& Level = Levels[LevelIndex];
+	Level.Offset = Offset;
+	Level.Scale = Scale;
+
+	if (SceneProxy && !IsRenderStateDirty())
+	{
+		// Enqueue command to modify render thread info
+		FGeoClipProceduralMeshSceneProxy* ProcMeshSceneProxy = (FGeoClipProceduralMeshSceneProxy*)SceneProxy;
+		ENQUEUE_RENDER_COMMAND(FGeoCProcMeshLevelTransformUpdate)(
+			[ProcMeshSceneProxy, LevelIndex, LevelToLocal = Level.GetLevelToLocal()](FRHICommandListImmediate& RHICmdList)
+			{
+				ProcMeshSceneProxy->SetLevelTransform_RenderThread(LevelIndex, LevelToLocal);
+			});
+	}
+
+	// Bounds are padded when computed, most moves stay inside them. Occlusion bounds have no slack and follow every move
+	if (!UseCustomBounds && Level.SectionsBox.IsValid && !LocalBounds.GetBox().IsInside(Level.SectionsBox.TransformBy(Level.GetLevelToLocal())))
+	{
+		UpdateLocalBounds();
+	}
+	else if (!UseCustomBounds)
+	{
+		UpdateOcclusionBounds();
+	}
+}
+
 void UGeoClipmapMeshComponent::UpdateMeshSection_LinearColor(int32 SectionIndex, const TArray<FVector>& Vertices, const TArray<FVector>& Normals, const TArray<FVector2D>& UV0, const TArray<FVector2D>& UV1, const TArray<FVector2D>& UV2, const TArray<FVector2D>& UV3, const TArray<FLinearColor>& VertexColors, const TArray<FGeoCProcMeshTangent>& Tangents)
 {
 	// Convert FLinearColors to FColors
@@ -812,6 +1335,72 @@ void UGeoClipmapMeshComponent::UpdateMeshSection_LinearColor(int32 SectionIndex,
 	UpdateMeshSection(SectionIndex, Vertices, Normals, UV0, UV1, UV2, UV3, Colors, Tangents);
 }
 
+void UGeoClipmapMeshComponent::UpdateCustomBounds(int32 SectionIndex, const FBox& SectionBox, TArrayView<const FBox> BlockBoxes)
+{
+	const TArray<FBox> SectionBlockBoxes(BlockBoxes.GetData(), BlockBoxes.Num());
+	UpdateCustomBounds(SectionIndex, MakeArrayView(&SectionBox, 1), MakeArrayView(&SectionBlockBoxes, 1));
+}
+
+void UGeoClipmapMeshComponent::UpdateCustomBounds(int32 FirstSectionIndex, TArrayView<const FBox> SectionBoxes, TArrayView<const TArray<FBox>> BlockBoxes)
+{
+	struct FSectionBoundsUpdate
+	{
+		int32 SectionIndex;
+		int32 LevelIndex;
+		TArray<FBoxSphereBounds> BlockBounds;
+	};
+	TArray<FSectionBoundsUpdate> Updates;
+	Updates.Reserve(SectionBoxes.Num());
+
+	for (int32 Idx = 0; Idx < SectionBoxes.Num() && FirstSectionIndex + Idx < ProcMeshSections.Num(); Idx++)
+	{
+		FGeoCProcMeshSection& Section = ProcMeshSections[FirstSectionIndex + Idx];
+		Section.SectionLocalBox = SectionBoxes[Idx];
+
+		FSectionBoundsUpdate& Update = Updates.AddDefaulted_GetRef();
+		Update.SectionIndex = FirstSectionIndex + Idx;
+		Update.LevelIndex = Section.LevelIndex;
+
+		if (BlockBoxes.IsValidIndex(Idx) && BlockBoxes[Idx].Num() == Section.SharedBlocks.Num())
+		{
+			Update.BlockBounds.Reserve(BlockBoxes[Idx].Num());
+			for (int32 BlockIdx = 0; BlockIdx < BlockBoxes[Idx].Num(); BlockIdx++)
+			{
+				Section.SharedBlocks[BlockIdx].LocalBox = BlockBoxes[Idx][BlockIdx];
+				Update.BlockBounds.Add(FBoxSphereBounds(BlockBoxes[Idx][BlockIdx]));
+			}
+		}
+	}
+
+	if (Updates.Num() == 0)
+	{
+		return;
+	}
+
+	UpdateLocalBounds(); // Update level, overall and occlusion bounds once for every section
+
+	// If we have a valid proxy and it is not pending recreation
+	if (SceneProxy && !IsRenderStateDirty())
+	{
+		TArray<FBoxSphereBounds> LevelBounds;
+		LevelBounds.Reserve(Updates.Num());
+		for (const FSectionBoundsUpdate& Update : Updates)
+		{
+			LevelBounds.Add(Levels.IsValidIndex(Update.LevelIndex) && Levels[Update.LevelIndex].SectionsBox.IsValid ? FBoxSphereBounds(Levels[Update.LevelIndex].SectionsBox) : FBoxSphereBounds(ForceInit));
+		}
+
+		FGeoClipProceduralMeshSceneProxy* ProcMeshSceneProxy = (FGeoClipProceduralMeshSceneProxy*)SceneProxy;
+		ENQUEUE_RENDER_COMMAND(FGeoCProcMeshSectionBoundsUpdate)(
+			[ProcMeshSceneProxy, Updates = MoveTemp(Updates), LevelBounds = MoveTemp(LevelBounds)](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				for (int32 Idx = 0; Idx < Updates.Num(); Idx++)
+				{
+					ProcMeshSceneProxy->UpdateSectionBounds_RenderThread(Updates[Idx].SectionIndex, MoveTemp(Updates[Idx].BlockBounds), Updates[Idx].LevelIndex, LevelBounds[Idx]);
+				}
+			});
+	}
+}
+
 void UGeoClipmapMeshComponent::UpdateCustomBounds(FBoxSphereBounds Newbound)
 {
 	UseCustomBounds=true;
@@ -839,101 +1428,130 @@ void UGeoClipmapMeshComponent::UpdateMeshSection(int32 SectionIndex, const TArra
 	{
 		FGeoCProcMeshSection& Section = ProcMeshSections[SectionIndex];
 		const int32 NumVerts = Vertices.Num();
-		const int32 PreviousNumVerts = Section.ProcVertexBuffer.Num();
+		const int32 PreviousNumVerts = Section.GetNumUpdatableVertices();
+
+		// Owned compact and bufferless sections keep no full vertices to update
+		if (!Section.SharedSection.IsValid() && (Section.UsesCompactVertices() || Section.UsesBufferlessVertices()))
+		{
+			UE_LOG(LogGeoClipProceduralComponent, Error, TEXT("Trying to update procedural mesh component section %d, which stores compact or bufferless vertices (clear and recreate mesh section instead)"), SectionIndex);
+			return;
+		}
+
+		// Shared geometry is read only, take a copy of the vertices this section references and let the proxy be recreated with its own buffers
+		if (Section.SharedSection.IsValid() && PreviousNumVerts == NumVerts)
+		{
+			Section.DetachSharedSection();
+			MarkRenderStateDirty();
+		}
 
 		// See if positions are changing
 		const bool bSameVertexCount = PreviousNumVerts == NumVerts;
 
+		// Streams the section was created without have no GPU buffer yet, recreate the proxy to allocate them
+		if (bSameVertexCount)
+		{
+			const uint8 NumTexCoords = FMath::Max<uint8>(Section.NumTexCoords, UV3.Num() == NumVerts ? 4 : UV2.Num() == NumVerts ? 3 : UV1.Num() == NumVerts ? 2 : 1);
+			const bool bHasVertexColors = Section.bHasVertexColors || VertexColors.Num() == NumVerts;
+			const bool bHasTangents = Section.bHasTangents || Normals.Num() == NumVerts || Tangents.Num() == NumVerts;
+			if (NumTexCoords != Section.NumTexCoords || bHasVertexColors != Section.bHasVertexColors || bHasTangents != Section.bHasTangents)
+			{
+				Section.NumTexCoords = NumTexCoords;
+				Section.bHasVertexColors = bHasVertexColors;
+				Section.bHasTangents = bHasTangents;
+				Section.RenderCache.Reset();
+				MarkRenderStateDirty();
+			}
+		}
+
 		// Update bounds, if we are getting new position data
 		if (bSameVertexCount)
 		{
 			Section.SectionLocalBox = FBox(Vertices);
 
-			// Iterate through vertex data, copying in new info
+			// Iterate through vertex data, copying in new info and recording which vertices and streams changed
+			EGeoClipmapVertexStreams DirtyStreams = EGeoClipmapVertexStreams::None;
+			TArray<FGeoClipmapVertexRange> DirtyRanges;
+
 			for (int32 VertIdx = 0; VertIdx < NumVerts; VertIdx++)
 			{
 				FGeoCProcMeshVertex& ModifyVert = Section.ProcVertexBuffer[VertIdx];
+				EGeoClipmapVertexStreams VertexStreams = EGeoClipmapVertexStreams::None;
 
 				// Position data
-				if (Vertices.Num() == NumVerts)
+				if (Vertices.Num() == NumVerts && ModifyVert.Position != Vertices[VertIdx])
 				{
 					ModifyVert.Position = Vertices[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::Position;
 				}
 
 				// Normal data
-				if (Normals.Num() == NumVerts)
+				if (Normals.Num() == NumVerts && ModifyVert.Normal != Normals[VertIdx])
 				{
 					ModifyVert.Normal = Normals[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::Tangents;
 				}
 
 				// Tangent data
-				if (Tangents.Num() == NumVerts)
+				if (Tangents.Num() == NumVerts && (ModifyVert.Tangent.TangentX != Tangents[VertIdx].TangentX || ModifyVert.Tangent.bFlipTangentY != Tangents[VertIdx].bFlipTangentY))
 				{
 					ModifyVert.Tangent = Tangents[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::Tangents;
 				}
 
 				// UV0 data
-				if (UV0.Num() == NumVerts)
+				if (UV0.Num() == NumVerts && ModifyVert.UV0 != UV0[VertIdx])
 				{
 					ModifyVert.UV0 = UV0[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::TexCoords;
 				}
 				// UV1 data
-				if (UV1.Num() == NumVerts)
+				if (UV1.Num() == NumVerts && ModifyVert.UV1 != UV1[VertIdx])
 				{
 					ModifyVert.UV1 = UV1[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::TexCoords;
 				}
 				// UV2 data
-				if (UV2.Num() == NumVerts)
+				if (UV2.Num() == NumVerts && ModifyVert.UV2 != UV2[VertIdx])
 				{
 					ModifyVert.UV2 = UV2[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::TexCoords;
 				}
 				// UV3 data
-				if (UV3.Num() == NumVerts)
+				if (UV3.Num() == NumVerts && ModifyVert.UV3 != UV3[VertIdx])
 				{
 					ModifyVert.UV3 = UV3[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::TexCoords;
 				}
 
 				// Color data
-				if (VertexColors.Num() == NumVerts)
+				if (VertexColors.Num() == NumVerts && ModifyVert.Color != VertexColors[VertIdx])
 				{
 					ModifyVert.Color = VertexColors[VertIdx];
+					VertexStreams |= EGeoClipmapVertexStreams::Color;
 				}
-			}
-
-			// If we have collision enabled on this section, update that too
-			if (Section.bEnableCollision)
-			{
-				TArray<FVector> CollisionPositions;
 
-				// We have one collision mesh for all sections, so need to build array of _all_ positions
-				for (const FGeoCProcMeshSection& CollisionSection : ProcMeshSections)
+				if (VertexStreams != EGeoClipmapVertexStreams::None)
 				{
-					// If section has collision, copy it
-					if (CollisionSection.bEnableCollision)
-					{
-						for (int32 VertIdx = 0; VertIdx < CollisionSection.ProcVertexBuffer.Num(); VertIdx++)
-						{
-							CollisionPositions.Add(CollisionSection.ProcVertexBuffer[VertIdx].Position);
-						}
-					}
+					DirtyStreams |= VertexStreams;
+					AddGeoClipmapDirtyVertex(DirtyRanges, VertIdx);
 				}
+			}
 
-				// Pass new positions to trimesh
-				BodyInstance.UpdateTriMeshVertices(CollisionPositions);
+			// If we have collision enabled on this section and positions changed, update that too
+			if (Section.bEnableCollision && EnumHasAnyFlags(DirtyStreams, EGeoClipmapVertexStreams::Position))
+			{
+				UpdateCollisionVertices();
 			}
 
-			// If we have a valid proxy and it is not pending recreation
-			if (SceneProxy && !IsRenderStateDirty())
+			// If the section has buffers, send only the vertices that changed. Buffers outlive the proxy, a recreated proxy draws the updated ones
+			if (Section.RenderCache.IsValid() && DirtyRanges.Num() > 0)
 			{
-				// Create data to update section
-				FGeoCProcMeshSectionUpdateData* SectionData = new FGeoCProcMeshSectionUpdateData;
-				SectionData->TargetSection = SectionIndex;
-				SectionData->NewVertexBuffer = Section.ProcVertexBuffer;
+				// Fill a pooled packet directly in the formats of the section buffers
+				FGeoCProcMeshSectionUpdateData* SectionData = FGeoCProcMeshSectionUpdateData::Acquire();
+				SectionData->Vertices.Fill(Section.ProcVertexBuffer, MoveTemp(DirtyRanges), DirtyStreams, FMath::Clamp<int32>(Section.NumTexCoords, 1, 4));
 
 				// Enqueue command to send to render thread
-				FGeoClipProceduralMeshSceneProxy* ProcMeshSceneProxy = (FGeoClipProceduralMeshSceneProxy*)SceneProxy;
-				ENQUEUE_RENDER_COMMAND(FGeoCProcMeshSectionUpdate)
-				([ProcMeshSceneProxy, SectionData](FRHICommandListImmediate& RHICmdList) { ProcMeshSceneProxy->UpdateSection_RenderThread(SectionData); });
+				EnqueueGeoClipmapSectionUpdate(Section.RenderCache, SectionData);
 			}
 
 			UpdateLocalBounds();		 // Update overall bounds
@@ -946,6 +1564,128 @@ void UGeoClipmapMeshComponent::UpdateMeshSection(int32 SectionIndex, const TArra
 	}
 }
 
+void UGeoClipmapMeshComponent::UpdateMeshSectionPositions(int32 SectionIndex, TArrayView<const FVector3f> Positions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GeoClipProcMesh_UpdateSectionGT);
+
+	if (SectionIndex >= ProcMeshSections.Num())
+	{
+		return;
+	}
+
+	FGeoCProcMeshSection& Section = ProcMeshSections[SectionIndex];
+	const int32 NumVerts = Section.SharedSection.IsValid() ? Section.GetNumUpdatableVertices() : Section.GetNumVertices();
+
+	if (Positions.Num() != NumVerts)
+	{
+		UE_LOG(LogGeoClipProceduralComponent, Error, TEXT("Trying to update the positions of a procedural mesh component section with a different number of vertices [Previous: %i, New: %i] (clear and recreate mesh section instead)"), NumVerts, Positions.Num());
+		return;
+	}
+
+	// Shared geometry is read only, take a copy and let the proxy be recreated with its own buffers
+	if (Section.SharedSection.IsValid())
+	{
+		Section.DetachSharedSection();
+		MarkRenderStateDirty();
+	}
+
+	// Owned compact and bufferless sections have no positions to update in place
+	if (!ensureMsgf(Section.ProcVertexBuffer.Num() == NumVerts, TEXT("UpdateMeshSectionPositions needs full vertices, section %d stores %d of its %d vertices (recreate it with UpdateMeshSection instead)"), SectionIndex, Section.ProcVertexBuffer.Num(), NumVerts))
+	{
+		return;
+	}
+
+	// Chunks are written, bounded and diffed in parallel, then merged in order
+	constexpr int32 ChunkSize = 4096;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumVerts, ChunkSize);
+
+	struct FPositionChunk
+	{
+		FBox Box = FBox(ForceInit);
+		int32 FirstDirty = INDEX_NONE;
+		int32 LastDirty = INDEX_NONE;
+	};
+	TArray<FPositionChunk, TInlineAllocator<64>> Chunks;
+	Chunks.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		FPositionChunk& Chunk = Chunks[ChunkIdx];
+		const int32 ChunkEnd = FMath::Min(NumVerts, (ChunkIdx + 1) * ChunkSize);
+
+		for (int32 VertIdx = ChunkIdx * ChunkSize; VertIdx < ChunkEnd; VertIdx++)
+		{
+			const FVector Position(Positions[VertIdx]);
+			Chunk.Box += Position;
+
+			FVector& ModifyPosition = Section.ProcVertexBuffer[VertIdx].Position;
+			if (ModifyPosition != Position)
+			{
+				ModifyPosition = Position;
+				Chunk.FirstDirty = Chunk.FirstDirty == INDEX_NONE ? VertIdx : Chunk.FirstDirty;
+				Chunk.LastDirty = VertIdx;
+			}
+		}
+	});
+
+	FBox SectionBox(ForceInit);
+	TArray<FGeoClipmapVertexRange> DirtyRanges;
+	for (const FPositionChunk& Chunk : Chunks)
+	{
+		SectionBox += Chunk.Box;
+
+		if (Chunk.FirstDirty != INDEX_NONE)
+		{
+			// Vertices between the first and last changed ones of a chunk are sent too, the CPU copy is already up to date
+			AddGeoClipmapDirtyRange(DirtyRanges, Chunk.FirstDirty, Chunk.LastDirty);
+		}
+	}
+	Section.SectionLocalBox = SectionBox;
+
+	if (DirtyRanges.Num() == 0)
+	{
+		return;
+	}
+
+	if (Section.bEnableCollision)
+	{
+		UpdateCollisionVertices();
+	}
+
+	// If the section has buffers, send only the positions that changed
+	if (Section.RenderCache.IsValid())
+	{
+		FGeoCProcMeshSectionUpdateData* SectionData = FGeoCProcMeshSectionUpdateData::Acquire();
+		SectionData->Vertices.FillPositions(Positions, MoveTemp(DirtyRanges));
+
+		EnqueueGeoClipmapSectionUpdate(Section.RenderCache, SectionData);
+	}
+
+	UpdateLocalBounds();		 // Update overall bounds
+	MarkRenderTransformDirty();  // Need to send new bounds to render thread
+}
+
+void UGeoClipmapMeshComponent::UpdateCollisionVertices()
+{
+	TArray<FVector> CollisionPositions;
+
+	// We have one collision mesh for all sections, so need to build array of _all_ positions
+	for (const FGeoCProcMeshSection& CollisionSection : ProcMeshSections)
+	{
+		// If section has collision, copy it
+		if (CollisionSection.bEnableCollision)
+		{
+			for (int32 VertIdx = 0; VertIdx < CollisionSection.GetVertexBuffer().Num(); VertIdx++)
+			{
+				CollisionPositions.Add(CollisionSection.GetVertexBuffer()[VertIdx].Position);
+			}
+		}
+	}
+
+	// Pass new positions to trimesh
+	BodyInstance.UpdateTriMeshVertices(CollisionPositions);
+}
+
 void UGeoClipmapMeshComponent::ClearMeshSection(int32 SectionIndex)
 {
 	if (SectionIndex < ProcMeshSections.Num())
@@ -960,6 +1700,7 @@ void UGeoClipmapMeshComponent::ClearMeshSection(int32 SectionIndex)
 void UGeoClipmapMeshComponent::ClearAllMeshSections()
 {
 	ProcMeshSections.Empty();
+	Levels.Empty();
 	UpdateLocalBounds();
 	UpdateCollision();
 	MarkRenderStateDirty();
@@ -972,15 +1713,10 @@ void UGeoClipmapMeshComponent::SetMeshSectionVisible(int32 SectionIndex, bool bN
 		// Set game thread state
 		ProcMeshSections[SectionIndex].bSectionVisible = bNewVisibility;
 
+		// Gathered with the other changes of this frame, see SendRenderDynamicData_Concurrent
 		if (SceneProxy)
 		{
-			// Enqueue command to modify render thread info
-			FGeoClipProceduralMeshSceneProxy* ProcMeshSceneProxy = (FGeoClipProceduralMeshSceneProxy*)SceneProxy;
-			ENQUEUE_RENDER_COMMAND(FGeoCProcMeshSectionVisibilityUpdate)(
-				[ProcMeshSceneProxy, SectionIndex, bNewVisibility](FRHICommandListImmediate& RHICmdList)
-				{
-					ProcMeshSceneProxy->SetSectionVisibility_RenderThread(SectionIndex, bNewVisibility);
-				});
+			MarkRenderDynamicDataDirty();
 		}
 
 		//MarkRenderStateDirty();
@@ -1044,26 +1780,121 @@ void UGeoClipmapMeshComponent::UpdateLocalBounds()
 {
 	FBox LocalBox(ForceInit);
 
+	for (FGeoClipmapLevel& Level : Levels)
+	{
+		Level.SectionsBox.Init();
+	}
+
 	for (const FGeoCProcMeshSection& Section : ProcMeshSections)
 	{
-		LocalBox += Section.SectionLocalBox;
+		if (Levels.IsValidIndex(Section.LevelIndex))
+		{
+			Levels[Section.LevelIndex].SectionsBox += Section.SectionLocalBox;
+		}
+		else
+		{
+			LocalBox += Section.SectionLocalBox;
+		}
+	}
+
+	UnleveledSectionsBox = LocalBox;
+
+	if (Levels.Num() > 0)
+	{
+		FBox LevelsBox(ForceInit);
+		for (const FGeoClipmapLevel& Level : Levels)
+		{
+			if (Level.SectionsBox.IsValid)
+			{
+				LevelsBox += Level.SectionsBox.TransformBy(Level.GetLevelToLocal());
+			}
+		}
+
+		// Levels move without updating the bounds until one of them leaves, leave them some room
+		if (LevelsBox.IsValid)
+		{
+			LocalBox += LevelsBox.ExpandBy(LevelsBox.GetExtent() * GeoClipmapLevelBoundsSlack);
+		}
 	}
 
 	LocalBounds = UseCustomBounds? LocalBoundsGeoC: (LocalBox.IsValid ? FBoxSphereBounds(LocalBox) : FBoxSphereBounds(FVector(0, 0, 0), FVector(0, 0, 0), 0)); // fallback to reset box sphere bounds
 
+	UpdateOcclusionBounds();
+
 	// Update global bounds
 	UpdateBounds();
 	// Need to send to render thread
 	MarkRenderTransformDirty();
 }
 
+void UGeoClipmapMeshComponent::UpdateOcclusionBounds()
+{
+	// Occlusion queries use the bounds without slack
+	FBox OcclusionBox = UnleveledSectionsBox;
+	for (const FGeoClipmapLevel& Level : Levels)
+	{
+		if (Level.SectionsBox.IsValid)
+		{
+			OcclusionBox += Level.SectionsBox.TransformBy(Level.GetLevelToLocal());
+		}
+	}
+
+	OcclusionLocalBounds = UseCustomBounds ? LocalBoundsGeoC : (OcclusionBox.IsValid ? FBoxSphereBounds(OcclusionBox) : LocalBounds);
+
+	if (SceneProxy)
+	{
+		// Read by the scene every frame, no transform update is needed
+		FGeoClipProceduralMeshSceneProxy* ProcMeshSceneProxy = (FGeoClipProceduralMeshSceneProxy*)SceneProxy;
+		ENQUEUE_RENDER_COMMAND(FGeoCProcMeshOcclusionBoundsUpdate)
+			([ProcMeshSceneProxy, NewBounds = OcclusionLocalBounds](FRHICommandListImmediate& RHICmdList) { ProcMeshSceneProxy->UpdateBounds_RenderThread(NewBounds); });
+	}
+}
+
 FPrimitiveSceneProxy* UGeoClipmapMeshComponent::CreateSceneProxy()
 {
 	SCOPE_CYCLE_COUNTER(STAT_GeoClipProcMesh_CreateSceneProxy);
 
+	// The new proxy copies the current visibility of each section
+	ProxySectionVisibility.Init(false, ProcMeshSections.Num());
+	for (int32 SectionIndex = 0; SectionIndex < ProcMeshSections.Num(); SectionIndex++)
+	{
+		ProxySectionVisibility[SectionIndex] = ProcMeshSections[SectionIndex].bSectionVisible;
+	}
+
 	return new FGeoClipProceduralMeshSceneProxy(this);
 }
 
+void UGeoClipmapMeshComponent::SendRenderDynamicData_Concurrent()
+{
+	Super::SendRenderDynamicData_Concurrent();
+
+	if (!SceneProxy)
+	{
+		return;
+	}
+
+	TBitArray<> SectionVisibility(false, ProcMeshSections.Num());
+	for (int32 SectionIndex = 0; SectionIndex < ProcMeshSections.Num(); SectionIndex++)
+	{
+		SectionVisibility[SectionIndex] = ProcMeshSections[SectionIndex].bSectionVisible;
+	}
+
+	// Sections toggled back and forth within the frame need no command
+	if (SectionVisibility == ProxySectionVisibility)
+	{
+		return;
+	}
+
+	ProxySectionVisibility = SectionVisibility;
+
+	FGeoClipProceduralMeshSceneProxy* ProcMeshSceneProxy = (FGeoClipProceduralMeshSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FGeoCProcMeshSectionVisibilityUpdate)(
+		[ProcMeshSceneProxy, SectionVisibility = MoveTemp(SectionVisibility)](FRHICommandListImmediate& RHICmdList)
+		{
+			ProcMeshSceneProxy->SetSectionsVisibility_RenderThread(SectionVisibility);
+		});
+}
+
 int32 UGeoClipmapMeshComponent::GetNumMaterials() const
 {
 	return ProcMeshSections.Num();
@@ -1092,6 +1923,8 @@ void UGeoClipmapMeshComponent::SetProcMeshSection(int32 SectionIndex, const FGeo
 	}
 
 	ProcMeshSections[SectionIndex] = Section;
+	// Content may differ from the buffers the copied section was drawn with
+	ProcMeshSections[SectionIndex].RenderCache.Reset();
 
 	UpdateLocalBounds(); // Update overall bounds
 	UpdateCollision(); // Mark collision as dirty
@@ -1126,27 +1959,29 @@ bool UGeoClipmapMeshComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionDat
 		// Do we have collision enabled?
 		if (Section.bEnableCollision)
 		{
+			const TArray<FGeoCProcMeshVertex>& SectionVertices = Section.GetVertexBuffer();
+
 			// Copy vert data
-			for (int32 VertIdx = 0; VertIdx < Section.ProcVertexBuffer.Num(); VertIdx++)
+			for (int32 VertIdx = 0; VertIdx < SectionVertices.Num(); VertIdx++)
 			{
-				CollisionData->Vertices.Add(FVector3f(Section.ProcVertexBuffer[VertIdx].Position));
+				CollisionData->Vertices.Add(FVector3f(SectionVertices[VertIdx].Position));
 
 				// Copy UV if desired
 				if (bCopyUVs)
 				{
-					CollisionData->UVs[0].Add(Section.ProcVertexBuffer[VertIdx].UV0);
+					CollisionData->UVs[0].Add(SectionVertices[VertIdx].UV0);
 				}
 			}
 
 			// Copy triangle data
-			const int32 NumTriangles = Section.ProcIndexBuffer.Num() / 3;
+			const int32 NumTriangles = Section.GetNumIndices() / 3;
 			for (int32 TriIdx = 0; TriIdx < NumTriangles; TriIdx++)
 			{
 				// Need to add base offset for indices
 				FTriIndices Triangle;
-				Triangle.v0 = Section.ProcIndexBuffer[(TriIdx * 3) + 0] + VertexBase;
-				Triangle.v1 = Section.ProcIndexBuffer[(TriIdx * 3) + 1] + VertexBase;
-				Triangle.v2 = Section.ProcIndexBuffer[(TriIdx * 3) + 2] + VertexBase;
+				Triangle.v0 = Section.GetIndex((TriIdx * 3) + 0) + VertexBase;
+				Triangle.v1 = Section.GetIndex((TriIdx * 3) + 1) + VertexBase;
+				Triangle.v2 = Section.GetIndex((TriIdx * 3) + 2) + VertexBase;
 				CollisionData->Indices.Add(Triangle);
 
 				// Also store material info
@@ -1169,7 +2004,7 @@ bool UGeoClipmapMeshComponent::ContainsPhysicsTriMeshData(bool InUseAllTriData)
 {
 	for (const FGeoCProcMeshSection& Section : ProcMeshSections)
 	{
-		if (Section.ProcIndexBuffer.Num() >= 3 && Section.bEnableCollision)
+		if (Section.GetNumIndices() >= 3 && Section.bEnableCollision)
 		{
 			return true;
 		}
@@ -1293,7 +2128,7 @@ UMaterialInterface* UGeoClipmapMeshComponent::GetMaterialFromCollisionFaceIndex(
 		for (int32 SectionIdx = 0; SectionIdx < ProcMeshSections.Num(); SectionIdx++)
 		{
 			const FGeoCProcMeshSection& Section = ProcMeshSections[SectionIdx];
-			int32 NumFaces = Section.ProcIndexBuffer.Num() / 3;
+			int32 NumFaces = Section.GetNumIndices() / 3;
 			TotalFaceCount += NumFaces;
 
 			if (FaceIndex < TotalFaceCount)
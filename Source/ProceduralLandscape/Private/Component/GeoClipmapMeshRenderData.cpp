@@ -0,0 +1,522 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "GeoClipmapMeshRenderData.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_MEMORY_STAT(TEXT("GeoClip ProcMesh Section Buffers"), STAT_GeoClipProcMesh_SectionBufferMemory, STATGROUP_GeoClipProceduralMesh);
+
+static TGlobalResource<FGeoClipmapUpTangentVertexBuffer> GGeoClipmapUpTangents;
+
+static void UploadGeoClipmapVertexBuffer(FRHIBuffer* VertexBufferRHI, const void* Data, uint32 SizeInBytes)
+{
+	void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, SizeInBytes, RLM_WriteOnly);
+	FMemory::Memcpy(VertexBufferData, Data, SizeInBytes);
+	RHIUnlockVertexBuffer(VertexBufferRHI);
+}
+
+/** Upload NumVertices vertices starting at FirstVertex, BufferData being the CPU copy of the whole buffer */
+static void UploadGeoClipmapVertexRange(FRHIBuffer* VertexBufferRHI, const void* BufferData, uint32 Stride, int32 FirstVertex, int32 NumVertices)
+{
+	const uint32 Offset = FirstVertex * Stride;
+	const uint32 SizeInBytes = NumVertices * Stride;
+
+	void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, Offset, SizeInBytes, RLM_WriteOnly);
+	FMemory::Memcpy(VertexBufferData, (const uint8*)BufferData + Offset, SizeInBytes);
+	RHIUnlockVertexBuffer(VertexBufferRHI);
+}
+
+void FGeoClipmapTexCoordVertexBuffer::Init(int32 InNumVertices, int32 InNumTexCoords)
+{
+	NumTexCoords = FMath::Clamp(InNumTexCoords, 1, 4);
+	bFullPrecision = UsesFullPrecision();
+	Data.SetNumZeroed(InNumVertices * GetStride());
+}
+
+void FGeoClipmapTexCoordVertexBuffer::WriteVertexUVs(uint8* VertexData, const FGeoCProcMeshVertex& Vertex, int32 InNumTexCoords, bool bInFullPrecision)
+{
+	const FVector2D UVs[4] = { Vertex.UV0, Vertex.UV1, Vertex.UV2, Vertex.UV3 };
+	for (int32 UVIndex = 0; UVIndex < InNumTexCoords; UVIndex++)
+	{
+		if (bInFullPrecision)
+		{
+			((FVector2f*)VertexData)[UVIndex] = FVector2f(UVs[UVIndex]);
+		}
+		else
+		{
+			((FVector2DHalf*)VertexData)[UVIndex] = FVector2DHalf(FVector2f(UVs[UVIndex]));
+		}
+	}
+}
+
+void FGeoClipmapTexCoordVertexBuffer::InitRHI()
+{
+	if (Data.Num() == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(TEXT("FGeoClipmapTexCoordVertexBuffer"));
+	VertexBufferRHI = RHICreateVertexBuffer(Data.Num(), BUF_Static | BUF_ShaderResource, CreateInfo);
+	UploadGeoClipmapVertexBuffer(VertexBufferRHI, Data.GetData(), Data.Num());
+
+	// Manual vertex fetch reads the channels through this view
+	SRV = RHICreateShaderResourceView(VertexBufferRHI, GetElementSize(), bFullPrecision ? PF_G32R32F : PF_G16R16F);
+}
+
+void FGeoClipmapTexCoordVertexBuffer::ReleaseRHI()
+{
+	SRV.SafeRelease();
+	FVertexBuffer::ReleaseRHI();
+}
+
+void FGeoClipmapTangentVertexBuffer::PackVertexTangents(const FGeoCProcMeshVertex& Vertex, FPackedNormal* OutTangents)
+{
+	FPackedNormal TangentZ(FVector3f(Vertex.Normal));
+	TangentZ.Vector.W = Vertex.Tangent.bFlipTangentY ? -127 : 127;
+	OutTangents[0] = FPackedNormal(FVector3f(Vertex.Tangent.TangentX));
+	OutTangents[1] = TangentZ;
+}
+
+void FGeoClipmapTangentVertexBuffer::InitRHI()
+{
+	const uint32 SizeInBytes = Tangents.Num() * sizeof(FPackedNormal);
+	if (SizeInBytes == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(*GetFriendlyName());
+	VertexBufferRHI = RHICreateVertexBuffer(SizeInBytes, BUF_Static | BUF_ShaderResource, CreateInfo);
+	UploadGeoClipmapVertexBuffer(VertexBufferRHI, Tangents.GetData(), SizeInBytes);
+
+	SRV = RHICreateShaderResourceView(VertexBufferRHI, sizeof(FPackedNormal), PF_R8G8B8A8_SNORM);
+}
+
+void FGeoClipmapTangentVertexBuffer::ReleaseRHI()
+{
+	SRV.SafeRelease();
+	FVertexBuffer::ReleaseRHI();
+}
+
+void FGeoClipmapUpTangentVertexBuffer::Reserve(int32 InNumVertices)
+{
+	check(IsInRenderingThread());
+
+	if (InNumVertices <= NumVertices)
+	{
+		return;
+	}
+
+	// Power of two steps, growing sections only reallocate it a few times
+	NumVertices = FMath::Min<int32>(FMath::RoundUpToPowerOfTwo(InNumVertices), MaxVertices);
+	UpdateRHI();
+}
+
+void FGeoClipmapUpTangentVertexBuffer::InitRHI()
+{
+	Tangents.SetNumUninitialized(NumVertices * 2);
+	for (int32 VertIdx = 0; VertIdx < NumVertices; VertIdx++)
+	{
+		Tangents[VertIdx * 2 + 0] = FPackedNormal(FVector3f(1.f, 0.f, 0.f));
+		Tangents[VertIdx * 2 + 1] = FPackedNormal(FVector4f(0.f, 0.f, 1.f, 1.f));
+	}
+
+	FGeoClipmapTangentVertexBuffer::InitRHI();
+
+	// Never updated, no need for a CPU copy
+	Tangents.Empty();
+}
+
+void FGeoClipmapVertexUpdate::Reset()
+{
+	Streams = EGeoClipmapVertexStreams::None;
+	Ranges.Reset();
+	Positions.Reset();
+	Tangents.Reset();
+	TexCoords.Reset();
+	TexCoordStride = 0;
+	Colors.Reset();
+	NumVertices = 0;
+}
+
+void FGeoClipmapVertexUpdate::Fill(TArrayView<const FGeoCProcMeshVertex> Vertices, TArray<FGeoClipmapVertexRange>&& InRanges, EGeoClipmapVertexStreams InStreams, int32 NumTexCoords)
+{
+	Reset();
+
+	Streams = InStreams;
+	Ranges = MoveTemp(InRanges);
+
+	for (const FGeoClipmapVertexRange& Range : Ranges)
+	{
+		NumVertices += Range.NumVertices;
+	}
+
+	const bool bFullPrecision = FGeoClipmapTexCoordVertexBuffer::UsesFullPrecision();
+	TexCoordStride = FGeoClipmapTexCoordVertexBuffer::GetStride(NumTexCoords, bFullPrecision);
+
+	// Pooled updates keep their capacity, no allocation once they have seen a large enough update
+	if (EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::Position))
+	{
+		Positions.SetNumUninitialized(NumVertices, false);
+	}
+	if (EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::Tangents))
+	{
+		Tangents.SetNumUninitialized(NumVertices * 2, false);
+	}
+	if (EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::TexCoords))
+	{
+		TexCoords.SetNumUninitialized(NumVertices * TexCoordStride, false);
+	}
+	if (EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::Color))
+	{
+		Colors.SetNumUninitialized(NumVertices, false);
+	}
+
+	int32 UpdateIdx = 0;
+	for (const FGeoClipmapVertexRange& Range : Ranges)
+	{
+		for (int32 VertIdx = Range.FirstVertex; VertIdx < Range.FirstVertex + Range.NumVertices; VertIdx++, UpdateIdx++)
+		{
+			const FGeoCProcMeshVertex& Vertex = Vertices[VertIdx];
+
+			if (Positions.Num() > 0)
+			{
+				Positions[UpdateIdx] = FVector3f(Vertex.Position);
+			}
+			if (Tangents.Num() > 0)
+			{
+				FGeoClipmapTangentVertexBuffer::PackVertexTangents(Vertex, &Tangents[UpdateIdx * 2]);
+			}
+			if (TexCoords.Num() > 0)
+			{
+				FGeoClipmapTexCoordVertexBuffer::WriteVertexUVs(&TexCoords[UpdateIdx * TexCoordStride], Vertex, NumTexCoords, bFullPrecision);
+			}
+			if (Colors.Num() > 0)
+			{
+				Colors[UpdateIdx] = Vertex.Color;
+			}
+		}
+	}
+}
+
+void FGeoClipmapVertexUpdate::FillPositions(TArrayView<const FVector3f> AllPositions, TArray<FGeoClipmapVertexRange>&& InRanges)
+{
+	Reset();
+
+	Streams = EGeoClipmapVertexStreams::Position;
+	Ranges = MoveTemp(InRanges);
+
+	for (const FGeoClipmapVertexRange& Range : Ranges)
+	{
+		NumVertices += Range.NumVertices;
+	}
+
+	// Already in the format of the position buffer, each range is a single copy
+	Positions.SetNumUninitialized(NumVertices, false);
+
+	int32 UpdateIdx = 0;
+	for (const FGeoClipmapVertexRange& Range : Ranges)
+	{
+		FMemory::Memcpy(&Positions[UpdateIdx], &AllPositions[Range.FirstVertex], Range.NumVertices * sizeof(FVector3f));
+		UpdateIdx += Range.NumVertices;
+	}
+}
+
+FGeoClipmapSectionRenderData::FGeoClipmapSectionRenderData(ERHIFeatureLevel::Type InFeatureLevel)
+	: VertexFactory(InFeatureLevel, "FGeoClipmapSectionRenderData")
+	, CompactVertexFactory(InFeatureLevel)
+	, BufferlessVertexFactory(InFeatureLevel)
+{
+}
+
+void FGeoClipmapSectionRenderData::InitFromSection(const FGeoCProcMeshSection& Section)
+{
+	FillFromSection(Section);
+	BeginInitResources();
+}
+
+void FGeoClipmapSectionRenderData::FillFromSection(const FGeoCProcMeshSection& Section)
+{
+	// Copy index buffer, 16 bit when the section allows it
+	bUse16BitIndices = Section.Uses16BitIndices();
+	if (bUse16BitIndices)
+	{
+		IndexBuffer16.Indices = Section.ProcIndexBuffer16;
+	}
+	else
+	{
+		IndexBuffer.Indices = Section.ProcIndexBuffer;
+	}
+
+	bBufferless = Section.UsesBufferlessVertices();
+	if (bBufferless)
+	{
+		NumBufferlessVertices = Section.GetNumVertices();
+		BufferlessVertexFactory.SetData(Section.GridPatches, Section.CompactVerticalJitter);
+		return;
+	}
+
+	bCompactVertices = Section.UsesCompactVertices();
+	if (bCompactVertices)
+	{
+		CompactVertexBuffer.Vertices = Section.CompactVertexBuffer;
+		CompactVertexFactory.SetData(&CompactVertexBuffer, Section.CompactVerticalJitter);
+		return;
+	}
+
+	const int32 NumVerts = Section.ProcVertexBuffer.Num();
+
+	// Streams the section was never given are not allocated, past the shared up tangents capacity the section keeps its own
+	bHasTangents = Section.bHasTangents || NumVerts > FGeoClipmapUpTangentVertexBuffer::MaxVertices;
+	bHasVertexColors = Section.bHasVertexColors;
+
+	PositionVertexBuffer.Init(NumVerts);
+	TexCoordVertexBuffer.Init(NumVerts, Section.NumTexCoords);
+	if (bHasTangents)
+	{
+		TangentVertexBuffer.Tangents.SetNumUninitialized(NumVerts * 2);
+	}
+	if (bHasVertexColors)
+	{
+		ColorVertexBuffer.Init(NumVerts);
+	}
+
+	UpdateVertices_CPU(Section.ProcVertexBuffer, 0, EGeoClipmapVertexStreams::All);
+}
+
+void FGeoClipmapSectionRenderData::BeginInitResources()
+{
+	check(IsInGameThread());
+
+	const FIndexBuffer* ActiveIndexBuffer = bUse16BitIndices ? (FIndexBuffer*)&IndexBuffer16 : (FIndexBuffer*)&IndexBuffer;
+
+	if (bBufferless)
+	{
+		BeginInitResource((FIndexBuffer*)ActiveIndexBuffer);
+		BeginInitResource(&BufferlessVertexFactory);
+		return;
+	}
+
+	if (bCompactVertices)
+	{
+		BeginInitResource(&CompactVertexBuffer);
+		BeginInitResource((FIndexBuffer*)ActiveIndexBuffer);
+		BeginInitResource(&CompactVertexFactory);
+		return;
+	}
+
+	// Enqueue initialization of render resource
+	BeginInitResource(&PositionVertexBuffer);
+	BeginInitResource(&TexCoordVertexBuffer);
+	if (bHasTangents)
+	{
+		BeginInitResource(&TangentVertexBuffer);
+	}
+	if (bHasVertexColors)
+	{
+		BeginInitResource(&ColorVertexBuffer);
+	}
+	BeginInitResource((FIndexBuffer*)ActiveIndexBuffer);
+
+	FGeoClipmapSectionRenderData* RenderData = this;
+	ENQUEUE_RENDER_COMMAND(GeoClipmapBindSectionStreams)(
+		[RenderData](FRHICommandListImmediate& RHICmdList)
+		{
+			RenderData->BindVertexFactory_RenderThread();
+		});
+	BeginInitResource(&VertexFactory);
+}
+
+SIZE_T FGeoClipmapSectionRenderData::GetAllocatedSize() const
+{
+	SIZE_T Size = IndexBuffer.Indices.GetAllocatedSize() + IndexBuffer16.Indices.GetAllocatedSize() + CompactVertexBuffer.Vertices.GetAllocatedSize();
+
+	if (HasPositionVertexBuffer())
+	{
+		Size += PositionVertexBuffer.GetNumVertices() * PositionVertexBuffer.GetStride();
+		Size += TexCoordVertexBuffer.GetData().GetAllocatedSize();
+		Size += TangentVertexBuffer.Tangents.GetAllocatedSize();
+		Size += bHasVertexColors ? ColorVertexBuffer.GetNumVertices() * ColorVertexBuffer.GetStride() : 0;
+	}
+
+	return Size;
+}
+
+void FGeoClipmapSectionRenderData::UpdateVertices_CPU(TArrayView<const FGeoCProcMeshVertex> Vertices, int32 FirstVertex, EGeoClipmapVertexStreams Streams)
+{
+	const int32 NumVerts = FMath::Clamp<int32>(PositionVertexBuffer.GetNumVertices() - FirstVertex, 0, Vertices.Num());
+	const int32 NumTexCoords = TexCoordVertexBuffer.GetNumTexCoords();
+	const uint32 TexCoordStride = TexCoordVertexBuffer.GetStride();
+	const bool bFullPrecisionUVs = TexCoordVertexBuffer.GetElementSize() == sizeof(FVector2f);
+
+	const bool bUpdatePositions = EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::Position);
+	const bool bUpdateTexCoords = EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::TexCoords);
+	const bool bUpdateTangents = bHasTangents && EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::Tangents);
+	const bool bUpdateColors = bHasVertexColors && EnumHasAnyFlags(Streams, EGeoClipmapVertexStreams::Color);
+
+	// Every vertex writes its own elements of the final streams, chunks run in parallel
+	constexpr int32 ChunkSize = 2048;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumVerts, ChunkSize);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		const int32 ChunkEnd = FMath::Min(NumVerts, (ChunkIdx + 1) * ChunkSize);
+		for (int32 VertIdx = ChunkIdx * ChunkSize; VertIdx < ChunkEnd; VertIdx++)
+		{
+			const FGeoCProcMeshVertex& ProcVert = Vertices[VertIdx];
+			const int32 BufferIdx = FirstVertex + VertIdx;
+
+			if (bUpdatePositions)
+			{
+				PositionVertexBuffer.VertexPosition(BufferIdx) = FVector3f(ProcVert.Position);
+			}
+
+			if (bUpdateTexCoords)
+			{
+				FGeoClipmapTexCoordVertexBuffer::WriteVertexUVs(TexCoordVertexBuffer.GetVertexData() + BufferIdx * TexCoordStride, ProcVert, NumTexCoords, bFullPrecisionUVs);
+			}
+
+			if (bUpdateTangents)
+			{
+				FGeoClipmapTangentVertexBuffer::PackVertexTangents(ProcVert, &TangentVertexBuffer.Tangents[BufferIdx * 2]);
+			}
+
+			if (bUpdateColors)
+			{
+				ColorVertexBuffer.VertexColor(BufferIdx) = ProcVert.Color;
+			}
+		}
+	}, NumChunks == 1);
+}
+
+void FGeoClipmapSectionRenderData::UpdateVertices_RenderThread(const FGeoClipmapVertexUpdate& Update)
+{
+	check(IsInRenderingThread());
+
+	if (!HasPositionVertexBuffer())
+	{
+		return;
+	}
+
+	const int32 BufferNumVertices = PositionVertexBuffer.GetNumVertices();
+
+	// The update is already in the buffer formats, refresh the CPU copy of each range and upload only that range
+	auto UpdateStream = [BufferNumVertices, &Update](FRHIBuffer* VertexBufferRHI, uint8* CPUData, const uint8* UpdateData, uint32 Stride)
+	{
+		uint32 UpdateOffset = 0;
+		for (const FGeoClipmapVertexRange& Range : Update.Ranges)
+		{
+			const int32 NumVerts = FMath::Clamp<int32>(BufferNumVertices - Range.FirstVertex, 0, Range.NumVertices);
+			if (NumVerts > 0)
+			{
+				FMemory::Memcpy(CPUData + Range.FirstVertex * Stride, UpdateData + UpdateOffset, NumVerts * Stride);
+				UploadGeoClipmapVertexRange(VertexBufferRHI, CPUData, Stride, Range.FirstVertex, NumVerts);
+			}
+			UpdateOffset += Range.NumVertices * Stride;
+		}
+	};
+
+	if (Update.Positions.Num() > 0)
+	{
+		UpdateStream(PositionVertexBuffer.VertexBufferRHI, (uint8*)PositionVertexBuffer.GetVertexData(), (const uint8*)Update.Positions.GetData(), PositionVertexBuffer.GetStride());
+	}
+	// A section recreated with other UV channels since the update was filled gets its UVs from the new proxy
+	if (Update.TexCoords.Num() > 0 && Update.TexCoordStride == TexCoordVertexBuffer.GetStride())
+	{
+		UpdateStream(TexCoordVertexBuffer.VertexBufferRHI, TexCoordVertexBuffer.GetVertexData(), Update.TexCoords.GetData(), TexCoordVertexBuffer.GetStride());
+	}
+	if (bHasTangents && Update.Tangents.Num() > 0)
+	{
+		UpdateStream(TangentVertexBuffer.VertexBufferRHI, (uint8*)TangentVertexBuffer.Tangents.GetData(), (const uint8*)Update.Tangents.GetData(), FGeoClipmapTangentVertexBuffer::Stride);
+	}
+	if (bHasVertexColors && Update.Colors.Num() > 0)
+	{
+		UpdateStream(ColorVertexBuffer.VertexBufferRHI, (uint8*)ColorVertexBuffer.GetVertexData(), (const uint8*)Update.Colors.GetData(), ColorVertexBuffer.GetStride());
+	}
+}
+
+void FGeoClipmapSectionRenderData::BindVertexFactory_RenderThread()
+{
+	check(IsInRenderingThread());
+
+	FLocalVertexFactory::FDataType Data;
+	PositionVertexBuffer.BindPositionVertexBuffer(&VertexFactory, Data);
+
+	if (!bHasTangents)
+	{
+		GGeoClipmapUpTangents.Reserve(PositionVertexBuffer.GetNumVertices());
+	}
+
+	const FGeoClipmapTangentVertexBuffer& Tangents = bHasTangents ? TangentVertexBuffer : (const FGeoClipmapTangentVertexBuffer&)GGeoClipmapUpTangents;
+	Data.TangentBasisComponents[0] = FVertexStreamComponent(&Tangents, 0, FGeoClipmapTangentVertexBuffer::Stride, VET_PackedNormal, EVertexStreamUsage::ManualFetch);
+	Data.TangentBasisComponents[1] = FVertexStreamComponent(&Tangents, sizeof(FPackedNormal), FGeoClipmapTangentVertexBuffer::Stride, VET_PackedNormal, EVertexStreamUsage::ManualFetch);
+	Data.TangentsSRV = Tangents.SRV;
+
+	const int32 NumTexCoords = TexCoordVertexBuffer.GetNumTexCoords();
+	Data.TextureCoordinates.Empty(NumTexCoords);
+	for (int32 UVIndex = 0; UVIndex < NumTexCoords; UVIndex++)
+	{
+		Data.TextureCoordinates.Add(FVertexStreamComponent(&TexCoordVertexBuffer, UVIndex * TexCoordVertexBuffer.GetElementSize(), TexCoordVertexBuffer.GetStride(), TexCoordVertexBuffer.GetElementType(), EVertexStreamUsage::ManualFetch));
+	}
+	Data.TextureCoordinatesSRV = TexCoordVertexBuffer.SRV;
+	Data.NumTexCoords = NumTexCoords;
+	Data.LightMapCoordinateIndex = 0;
+	Data.LightMapCoordinateComponent = Data.TextureCoordinates[0];
+
+	if (bHasVertexColors)
+	{
+		ColorVertexBuffer.BindColorVertexBuffer(&VertexFactory, Data);
+	}
+	else
+	{
+		FColorVertexBuffer::BindDefaultColorVertexBuffer(&VertexFactory, Data, FColorVertexBuffer::NullBindStride::ZeroForDefaultBufferBind);
+	}
+
+	VertexFactory.SetData(Data);
+}
+
+void FGeoClipmapSectionRenderData::ReleaseResources()
+{
+	check(IsInRenderingThread());
+
+	PositionVertexBuffer.ReleaseResource();
+	TexCoordVertexBuffer.ReleaseResource();
+	TangentVertexBuffer.ReleaseResource();
+	ColorVertexBuffer.ReleaseResource();
+	IndexBuffer.ReleaseResource();
+	IndexBuffer16.ReleaseResource();
+	VertexFactory.ReleaseResource();
+	CompactVertexBuffer.ReleaseResource();
+	CompactVertexFactory.ReleaseResource();
+	BufferlessVertexFactory.ReleaseResource();
+}
+
+FGeoClipmapSectionRenderCache::FGeoClipmapSectionRenderCache(ERHIFeatureLevel::Type InFeatureLevel)
+	: RenderData(new FGeoClipmapSectionRenderData(InFeatureLevel))
+	, FeatureLevel(InFeatureLevel)
+{
+}
+
+FGeoClipmapSectionRenderCache::~FGeoClipmapSectionRenderCache()
+{
+	DEC_MEMORY_STAT_BY(STAT_GeoClipProcMesh_SectionBufferMemory, AllocatedSize);
+
+	// Last reference can be dropped by a proxy on the render thread, ENQUEUE_RENDER_COMMAND runs inline there
+	FGeoClipmapSectionRenderData* DataToRelease = RenderData;
+	RenderData = nullptr;
+
+	ENQUEUE_RENDER_COMMAND(ReleaseGeoClipmapSectionRenderCache)(
+		[DataToRelease](FRHICommandListImmediate& RHICmdList)
+		{
+			DataToRelease->ReleaseResources();
+			delete DataToRelease;
+		});
+}
+
+void FGeoClipmapSectionRenderCache::BeginInitResources()
+{
+	RenderData->BeginInitResources();
+
+	AllocatedSize = RenderData->GetAllocatedSize();
+	INC_MEMORY_STAT_BY(STAT_GeoClipProcMesh_SectionBufferMemory, AllocatedSize);
+}
@@ -0,0 +1,231 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+#include "LocalVertexFactory.h"
+#include "StaticMeshResources.h"
+#include "DynamicMeshBuilder.h"
+#include "Component/GeoClipmapMeshComponent.h"
+#include "GeoClipmapVertexFactory.h"
+
+/** Vertex streams of a section, so updates only upload the ones that changed */
+enum class EGeoClipmapVertexStreams : uint8
+{
+	None = 0,
+	Position = 1 << 0,
+	Tangents = 1 << 1,
+	TexCoords = 1 << 2,
+	Color = 1 << 3,
+	All = Position | Tangents | TexCoords | Color,
+};
+ENUM_CLASS_FLAGS(EGeoClipmapVertexStreams);
+
+/** Consecutive vertices of a section */
+struct FGeoClipmapVertexRange
+{
+	int32 FirstVertex = 0;
+	int32 NumVertices = 0;
+};
+
+/** Interleaved UV channels of a section, only the channels the section was created with. Half precision when the platform supports it, like FStaticMeshVertexBuffer */
+class FGeoClipmapTexCoordVertexBuffer : public FVertexBuffer
+{
+public:
+	/** Allocate the CPU copy, set before the resource is initialized */
+	void Init(int32 InNumVertices, int32 InNumTexCoords);
+
+	/** Write the first NumTexCoords UV channels of a vertex, in the layout of the buffer. Usable outside of the render thread */
+	static void WriteVertexUVs(uint8* VertexData, const FGeoCProcMeshVertex& Vertex, int32 InNumTexCoords, bool bInFullPrecision);
+
+	/** Whether UVs are stored as floats, on platforms without half precision vertex elements */
+	static bool UsesFullPrecision() { return !GVertexElementTypeSupport.IsSupported(VET_Half2); }
+	static uint32 GetStride(int32 InNumTexCoords, bool bInFullPrecision) { return InNumTexCoords * (bInFullPrecision ? sizeof(FVector2f) : sizeof(FVector2DHalf)); }
+
+	int32 GetNumTexCoords() const { return NumTexCoords; }
+	uint32 GetStride() const { return GetStride(NumTexCoords, bFullPrecision); }
+	uint32 GetElementSize() const { return bFullPrecision ? sizeof(FVector2f) : sizeof(FVector2DHalf); }
+	EVertexElementType GetElementType() const { return bFullPrecision ? VET_Float2 : VET_Half2; }
+	const TArray<uint8>& GetData() const { return Data; }
+	uint8* GetVertexData() { return Data.GetData(); }
+
+	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+	virtual FString GetFriendlyName() const override { return TEXT("FGeoClipmapTexCoordVertexBuffer"); }
+
+	FShaderResourceViewRHIRef SRV;
+
+private:
+	TArray<uint8> Data;
+	int32 NumTexCoords = 1;
+	bool bFullPrecision = false;
+};
+
+/** TangentX and TangentZ of each vertex, as FPackedNormal pairs */
+class FGeoClipmapTangentVertexBuffer : public FVertexBuffer
+{
+public:
+	TArray<FPackedNormal> Tangents;
+
+	static constexpr uint32 Stride = 2 * sizeof(FPackedNormal);
+
+	/** Pack TangentX and TangentZ of a vertex into OutTangents[0] and OutTangents[1] */
+	static void PackVertexTangents(const FGeoCProcMeshVertex& Vertex, FPackedNormal* OutTangents);
+
+	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+	virtual FString GetFriendlyName() const override { return TEXT("FGeoClipmapTangentVertexBuffer"); }
+
+	FShaderResourceViewRHIRef SRV;
+};
+
+/**
+*	Up facing tangents shared by every section created without normals nor tangents.
+*	Manual vertex fetch reads tangents per vertex so a single element is not enough. Empty until a section needs it,
+*	then grown to the largest of them.
+*/
+class FGeoClipmapUpTangentVertexBuffer : public FGeoClipmapTangentVertexBuffer
+{
+public:
+	static constexpr int32 MaxVertices = 512 * 512;
+
+	/** Render thread, grow to at least InNumVertices up tangents. Vertex factories bound to a smaller buffer keep it alive through their SRV */
+	void Reserve(int32 InNumVertices);
+
+	virtual void InitRHI() override;
+	virtual FString GetFriendlyName() const override { return TEXT("FGeoClipmapUpTangentVertexBuffer"); }
+
+private:
+	int32 NumVertices = 0;
+};
+
+/**
+*	New vertices of some ranges of a section, already in the formats of its vertex buffers.
+*	Filled on the game thread and uploaded as is on the render thread, then reused for a later update.
+*/
+class FGeoClipmapVertexUpdate
+{
+public:
+	/** Streams the update holds, the others are left untouched */
+	EGeoClipmapVertexStreams Streams = EGeoClipmapVertexStreams::None;
+	/** Updated ranges in increasing order, their vertices follow each other in the stream arrays */
+	TArray<FGeoClipmapVertexRange> Ranges;
+
+	TArray<FVector3f> Positions;
+	/** TangentX and TangentZ of each vertex */
+	TArray<FPackedNormal> Tangents;
+	/** Interleaved UV channels, TexCoordStride bytes per vertex */
+	TArray<uint8> TexCoords;
+	uint32 TexCoordStride = 0;
+	TArray<FColor> Colors;
+
+	/** Empty the update, keeping its allocations */
+	void Reset();
+
+	/** Convert the given streams of Vertices and append them. NumTexCoords is the UV channel count of the section buffers */
+	void Fill(TArrayView<const FGeoCProcMeshVertex> Vertices, TArray<FGeoClipmapVertexRange>&& InRanges, EGeoClipmapVertexStreams InStreams, int32 NumTexCoords);
+
+	/** Copy the ranges of new positions of every vertex, the other streams are left untouched */
+	void FillPositions(TArrayView<const FVector3f> AllPositions, TArray<FGeoClipmapVertexRange>&& InRanges);
+
+	int32 GetNumVertices() const { return NumVertices; }
+
+private:
+	int32 NumVertices = 0;
+};
+
+/** GPU buffers of one section, either owned by a scene proxy or shared through FGeoClipmapSharedSection */
+class FGeoClipmapSectionRenderData
+{
+public:
+	FGeoClipmapSectionRenderData(ERHIFeatureLevel::Type InFeatureLevel);
+
+	/** Game thread, copy the section into the buffers and enqueue their initialization. Only the streams the section was created with are allocated */
+	void InitFromSection(const FGeoCProcMeshSection& Section);
+
+	/** Any thread, copy the section into the CPU copies of the buffers. Sections are independent and can be filled in parallel */
+	void FillFromSection(const FGeoCProcMeshSection& Section);
+
+	/** Game thread, enqueue the initialization of the buffers once filled */
+	void BeginInitResources();
+
+	/** Bytes of vertex and index data, the same on the CPU and the GPU */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Render thread, copy the ranges of the update into the streams it holds and upload only those ranges of them */
+	void UpdateVertices_RenderThread(const FGeoClipmapVertexUpdate& Update);
+
+	/** Render thread, release every buffer */
+	void ReleaseResources();
+
+	int32 GetNumVertices() const { return bBufferless ? NumBufferlessVertices : bCompactVertices ? CompactVertexBuffer.Vertices.Num() : PositionVertexBuffer.GetNumVertices(); }
+	int32 GetNumIndices() const { return bUse16BitIndices ? IndexBuffer16.Indices.Num() : IndexBuffer.Indices.Num(); }
+
+	/** The 16 or 32 bit index buffer, whichever the section was initialized with */
+	const FIndexBuffer& GetIndexBuffer() const { return bUse16BitIndices ? (const FIndexBuffer&)IndexBuffer16 : (const FIndexBuffer&)IndexBuffer; }
+
+	/** The local, compact or bufferless vertex factory, whichever the section was initialized with */
+	const FVertexFactory* GetVertexFactory() const
+	{
+		return bBufferless ? (const FVertexFactory*)&BufferlessVertexFactory : bCompactVertices ? (const FVertexFactory*)&CompactVertexFactory : (const FVertexFactory*)&VertexFactory;
+	}
+
+	bool UsesCompactVertices() const { return bCompactVertices; }
+	bool UsesBufferlessVertices() const { return bBufferless; }
+	/** False for compact and bufferless sections, which have no position buffer to build ray tracing geometry from */
+	bool HasPositionVertexBuffer() const { return !bCompactVertices && !bBufferless; }
+
+	FPositionVertexBuffer PositionVertexBuffer;
+	FGeoClipmapTexCoordVertexBuffer TexCoordVertexBuffer;
+	/** Empty when the section uses the shared up tangents */
+	FGeoClipmapTangentVertexBuffer TangentVertexBuffer;
+	/** Empty when the section has no vertex colors, the factory then binds the default white color */
+	FColorVertexBuffer ColorVertexBuffer;
+	FDynamicMeshIndexBuffer32 IndexBuffer;
+	FDynamicMeshIndexBuffer16 IndexBuffer16;
+	FGeoClipmapLocalVertexFactory VertexFactory;
+	bool bUse16BitIndices = false;
+	bool bHasTangents = true;
+	bool bHasVertexColors = true;
+
+	/** Used instead of the local streams and VertexFactory by compact sections */
+	FGeoClipmapCompactVertexBuffer CompactVertexBuffer;
+	FGeoClipmapVertexFactory CompactVertexFactory;
+	bool bCompactVertices = false;
+
+	/** Bufferless sections only have an index buffer */
+	FGeoClipmapBufferlessVertexFactory BufferlessVertexFactory;
+	int32 NumBufferlessVertices = 0;
+	bool bBufferless = false;
+
+private:
+	/** Copy vertices starting at FirstVertex into the CPU copies of the given streams, among the ones this section has */
+	void UpdateVertices_CPU(TArrayView<const FGeoCProcMeshVertex> Vertices, int32 FirstVertex, EGeoClipmapVertexStreams Streams);
+
+	/** Render thread, point the local vertex factory at the allocated streams */
+	void BindVertexFactory_RenderThread();
+};
+
+/**
+*	Buffers of a section owned by a component, outliving the scene proxies drawing it.
+*	Released with the last reference, the component section or a proxy still drawing it.
+*/
+class FGeoClipmapSectionRenderCache
+{
+public:
+	explicit FGeoClipmapSectionRenderCache(ERHIFeatureLevel::Type InFeatureLevel);
+	~FGeoClipmapSectionRenderCache();
+
+	FGeoClipmapSectionRenderData* GetRenderData() const { return RenderData; }
+	ERHIFeatureLevel::Type GetFeatureLevel() const { return FeatureLevel; }
+
+	/** Game thread, enqueue the initialization of the buffers once filled with FGeoClipmapSectionRenderData::FillFromSection */
+	void BeginInitResources();
+
+private:
+	FGeoClipmapSectionRenderData* RenderData;
+	ERHIFeatureLevel::Type FeatureLevel;
+	/** Reported to STAT_GeoClipProcMesh_SectionBufferMemory while the buffers are alive */
+	SIZE_T AllocatedSize = 0;
+};
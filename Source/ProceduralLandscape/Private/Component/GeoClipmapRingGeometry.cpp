@@ -0,0 +1,544 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "Component/GeoClipmapRingGeometry.h"
+#include "GeoClipmapMeshRenderData.h"
+#include "GeoClipmapGridIndices.h"
+#include "GeoClipmapVertexCache.h"
+#include "RenderingThread.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+FCriticalSection FGeoClipmapRingGeometry::CacheLock;
+TMap<FGeoClipmapRingGeometryKey, TWeakPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe>> FGeoClipmapRingGeometry::Cache;
+
+FGeoClipmapSharedSection::~FGeoClipmapSharedSection()
+{
+	if (RenderData)
+	{
+		// Last reference can be dropped by a proxy on the render thread, ENQUEUE_RENDER_COMMAND runs inline there
+		FGeoClipmapSectionRenderData* DataToRelease = RenderData;
+		RenderData = nullptr;
+
+		ENQUEUE_RENDER_COMMAND(ReleaseGeoClipmapSharedSection)(
+			[DataToRelease](FRHICommandListImmediate& RHICmdList)
+			{
+				DataToRelease->ReleaseResources();
+				delete DataToRelease;
+			});
+	}
+}
+
+FGeoClipmapSectionRenderData* FGeoClipmapSharedSection::GetOrCreateRenderData(ERHIFeatureLevel::Type FeatureLevel) const
+{
+	FScopeLock Lock(&RenderDataLock);
+
+	if (!RenderData && Section.GetNumIndices() > 0 && Section.GetNumVertices() > 0)
+	{
+		RenderData = new FGeoClipmapSectionRenderData(FeatureLevel);
+		RenderData->InitFromSection(Section);
+	}
+
+	return RenderData;
+}
+
+TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> FGeoClipmapRingGeometry::Find(const FGeoClipmapRingGeometryKey& Key)
+{
+	FScopeLock Lock(&CacheLock);
+
+	if (TWeakPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe>* Found = Cache.Find(Key))
+	{
+		return Found->Pin();
+	}
+
+	return nullptr;
+}
+
+TSharedRef<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> FGeoClipmapRingGeometry::FindOrCreate(const FGeoClipmapRingGeometryKey& Key)
+{
+	if (TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> Existing = Find(Key))
+	{
+		return Existing.ToSharedRef();
+	}
+
+	// Built outside of the lock so a long build never blocks lookups of other keys
+	FGeoClipmapRingGeometry* NewGeometry = new FGeoClipmapRingGeometry(Key);
+	NewGeometry->Build();
+
+	TSharedRef<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> NewRef = MakeShareable(NewGeometry);
+
+	FScopeLock Lock(&CacheLock);
+
+	// Another thread may have built the same key meanwhile, keep the first one so levels keep sharing
+	if (TWeakPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe>* Found = Cache.Find(Key))
+	{
+		TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> Existing = Found->Pin();
+		if (Existing.IsValid())
+		{
+			return Existing.ToSharedRef();
+		}
+	}
+
+	Cache.Add(Key, NewRef);
+
+	// Drop entries nobody references anymore
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return NewRef;
+}
+
+FGeoClipmapRingGeometry::FGeoClipmapRingGeometry(const FGeoClipmapRingGeometryKey& InKey)
+	: Key(InKey)
+{
+}
+
+/** Triangles are relative to the BaseVertexIndex of their section, NumIndexedVertices is the vertex count of the largest section */
+static void FillSection(FGeoCProcMeshSection& Section, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, int32 NumIndexedVertices, const TArray<FVector2D>& UV, const TArray<FVector2D>& UV1, const TArray<FVector2D>& UV2)
+{
+	const int32 NumVerts = Vertices.Num();
+
+	Section.Reset();
+	Section.ProcVertexBuffer.SetNumUninitialized(NumVerts);
+
+	for (int32 VertIdx = 0; VertIdx < NumVerts; VertIdx++)
+	{
+		FGeoCProcMeshVertex& Vertex = Section.ProcVertexBuffer[VertIdx];
+
+		Vertex.Position = Vertices[VertIdx];
+		Vertex.Normal = FVector(0.f, 0.f, 1.f);
+		Vertex.Tangent = FGeoCProcMeshTangent(FVector(0.f, 0.f, 1.f), false);
+		Vertex.Color = FColor(255, 255, 255);
+		Vertex.UV0 = UV[VertIdx];
+		Vertex.UV1 = UV1[VertIdx];
+		Vertex.UV2 = UV2[VertIdx];
+		Vertex.UV3 = FVector2D(0.f, 0.f);
+
+		Section.SectionLocalBox += Vertex.Position;
+	}
+
+	Section.SetIndices(Triangles, Triangles.Num(), NumIndexedVertices);
+
+	// Normals, tangents and colors are constant, only position and UV0 to UV2 get buffers
+	Section.NumTexCoords = 3;
+	Section.bHasVertexColors = false;
+	Section.bHasTangents = false;
+}
+
+static uint16 GetCompactVertexFlags(const FVector& Vertex, const FVector2D& UV2)
+{
+	return (UV2.X > 0.5f ? GeoClipmapVertex_Interior : 0) | (Vertex.Z < 0.f ? GeoClipmapVertex_JitterDown : 0);
+}
+
+static void FillCompactSection(FGeoCProcMeshSection& Section, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, int32 NumIndexedVertices, const TArray<FVector2D>& UV2, float VerticalJitter)
+{
+	const int32 NumVerts = Vertices.Num();
+
+	Section.Reset();
+	Section.CompactVertexBuffer.SetNumUninitialized(NumVerts);
+	Section.CompactVerticalJitter = VerticalJitter;
+
+	for (int32 VertIdx = 0; VertIdx < NumVerts; VertIdx++)
+	{
+		FGeoClipmapCompactVertex& Vertex = Section.CompactVertexBuffer[VertIdx];
+
+		// Unit scaled grid of odd N, every vertex sits on an integer coordinate
+		Vertex.X = (int16)FMath::RoundToInt(Vertices[VertIdx].X);
+		Vertex.Y = (int16)FMath::RoundToInt(Vertices[VertIdx].Y);
+		Vertex.Flags = GetCompactVertexFlags(Vertices[VertIdx], UV2[VertIdx]);
+		Vertex.Padding = 0;
+
+		Section.SectionLocalBox += Vertices[VertIdx];
+	}
+
+	Section.SetIndices(Triangles, Triangles.Num(), NumIndexedVertices);
+
+	// Streams a detached copy expands to, see FGeoCProcMeshSection::DetachSharedSection
+	Section.NumTexCoords = 3;
+	Section.bHasVertexColors = false;
+	Section.bHasTangents = false;
+}
+
+static void FillBufferlessSection(FGeoCProcMeshSection& Section, const TArray<FGeoClipmapGridPatch>& Patches, float VerticalJitter, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, int32 NumIndexedVertices)
+{
+	check(Patches.Num() <= GEOCLIPMAP_MAX_GRID_PATCHES);
+
+	Section.Reset();
+	Section.GridPatches = Patches;
+	Section.CompactVerticalJitter = VerticalJitter;
+
+	// Vertices are only needed for the bounds, the GPU rebuilds them from the patches
+	for (const FVector& Vertex : Vertices)
+	{
+		Section.SectionLocalBox += Vertex;
+	}
+
+	Section.SetIndices(Triangles, Triangles.Num(), NumIndexedVertices);
+
+	// Streams a detached copy expands to, see FGeoCProcMeshSection::DetachSharedSection
+	Section.NumTexCoords = 3;
+	Section.bHasVertexColors = false;
+	Section.bHasTangents = false;
+}
+
+void FGeoClipmapRingGeometry::GetSectionGridPatches(const FGeoClipmapRingGeometryKey& RingKey, int32 SectionIndex, TArray<FGeoClipmapGridPatch>& Patches)
+{
+	const int32 N = RingKey.N;
+	const int32 LocalM = (N + 1) / 4;
+	const uint8 Outer = RingKey.StitchProfile;
+
+	// Unit scaled, one unit is one GridSpacing. N is odd so every vertex sits on an integer coordinate
+	const int32 LocalExtent = (N - 1) / 2;
+	const FIntPoint Origin = FIntPoint(-LocalExtent, -LocalExtent);
+
+	//inner L Shape have no stiching
+	const FIntPoint Inner = Origin + FIntPoint(LocalM - 1, LocalM - 1);
+
+	auto AddPatch = [&Patches](int32 NumX, int32 NumY, const FIntPoint& Offset, uint8 StitchProfile)
+	{
+		if (NumX < 2 || NumY < 2)
+			return;
+
+		FGeoClipmapGridPatch& Patch = Patches.AddDefaulted_GetRef();
+		Patch.FirstVertex = Patches.Num() > 1 ? Patches[Patches.Num() - 2].FirstVertex + Patches[Patches.Num() - 2].GetNumVertices() : 0;
+		Patch.NumX = NumX;
+		Patch.NumY = NumY;
+		Patch.Offset = Offset;
+		Patch.StitchProfile = StitchProfile;
+	};
+
+	Patches.Reset();
+
+	switch (SectionIndex)
+	{
+	case GeoClipmapRingSection::FullRing:
+		AddPatch(N, N, Origin, Outer);
+		break;
+
+	// Ring with a hole for the next level
+	case GeoClipmapRingSection::RingWithHole:
+		AddPatch(N, 3, Origin, Outer & (1 << 3 | 1 << 2 | 1 << 1));
+		AddPatch((LocalM - 1) * 2 + 3, (LocalM - 1) - 2 + 1, Origin + FIntPoint(LocalM - 1, 2), 0);
+		AddPatch((LocalM - 1) * 2 + 3, (LocalM - 1) - 2 + 1, Origin + FIntPoint(LocalM - 1, (LocalM - 1) * 3 + 2), 0);
+		AddPatch(N, 3, Origin + FIntPoint(0, (N - 1) - 2), Outer & (1 << 3 | 1 << 2 | 1));
+		AddPatch(LocalM, N - 4, Origin + FIntPoint(0, 2), Outer & (1 << 3));
+		AddPatch(LocalM, N - 4, Origin + FIntPoint((LocalM - 1) * 3 + 2, 2), Outer & (1 << 2));
+		break;
+
+	case GeoClipmapRingSection::InteriorBotLeft:
+		AddPatch(LocalM * 2 + 1, 2, Inner, 0);
+		AddPatch(2, LocalM * 2, Inner + FIntPoint(0, 1), 0);
+		break;
+
+	case GeoClipmapRingSection::InteriorTopLeft:
+		AddPatch(LocalM * 2 + 1, 2, Inner, 0);
+		AddPatch(2, LocalM * 2, Inner + FIntPoint(LocalM * 2 - 1, 1), 0);
+		break;
+
+	case GeoClipmapRingSection::InteriorBotRight:
+		AddPatch(2, LocalM * 2 + 1, Inner, 0);
+		AddPatch(LocalM * 2, 2, Inner + FIntPoint(1, LocalM * 2 - 1), 0);
+		break;
+
+	case GeoClipmapRingSection::InteriorTopRight:
+		AddPatch(2, LocalM * 2 + 1, Inner + FIntPoint(LocalM * 2 - 1, 0), 0);
+		AddPatch(LocalM * 2, 2, Inner + FIntPoint(0, LocalM * 2 - 1), 0);
+		break;
+	}
+}
+
+void FGeoClipmapRingGeometry::CreateSectionGeometry(const FGeoClipmapRingGeometryKey& RingKey, int32 SectionIndex, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UV, TArray<FVector2D>& UV1, TArray<FVector2D>& UV2)
+{
+	TArray<FGeoClipmapGridPatch> Patches;
+	GetSectionGridPatches(RingKey, SectionIndex, Patches);
+
+	for (const FGeoClipmapGridPatch& Patch : Patches)
+	{
+		CreateGridMeshWelded(Patch.NumX, Patch.NumY, Triangles, Vertices, UV, UV1, UV2, 1.f, FVector(Patch.Offset.X, Patch.Offset.Y, 0.f), Patch.StitchProfile, RingKey.VerticalJitter);
+	}
+}
+
+void FGeoClipmapRingGeometry::Build()
+{
+	const bool bOptimizeVertexCache = GeoClipmapVertexCache::IsOptimizationEnabled();
+
+	struct FSectionGeometry
+	{
+		TArray<FVector> Vertices;
+		TArray<int32> Triangles;
+		TArray<FVector2D> UV;
+		TArray<FVector2D> UV1;
+		TArray<FVector2D> UV2;
+		/** Number of indices of each non empty block, blocks are consecutive in Triangles */
+		TArray<int32> BlockNumIndices;
+	};
+	FSectionGeometry SectionGeometries[GeoClipmapRingSection::Num];
+
+	// Grids repeat across the sections of a ring only, the built ring is cached instead of its index tables
+	GeoClipmapGridIndices::FScopedTables ScopedGridTables;
+
+	// Sections are independent, each one is built on its own worker
+	ParallelFor(GeoClipmapRingSection::Num, [&](int32 SectionIndex)
+	{
+		FSectionGeometry& Geometry = SectionGeometries[SectionIndex];
+
+		CreateSectionGeometry(Key, SectionIndex, Geometry.Triangles, Geometry.Vertices, Geometry.UV, Geometry.UV1, Geometry.UV2);
+
+		// Group the triangles by the block their centroid falls in, the ring spans [-(N-1)/2, (N-1)/2]
+		const float LocalExtent = (Key.N - 1) / 2;
+		TArray<int32> BlockTriangles[NumBlocksPerSide * NumBlocksPerSide];
+		for (int32 TriIdx = 0; TriIdx < Geometry.Triangles.Num() / 3; TriIdx++)
+		{
+			const FVector Centroid = (Geometry.Vertices[Geometry.Triangles[TriIdx * 3]] + Geometry.Vertices[Geometry.Triangles[TriIdx * 3 + 1]] + Geometry.Vertices[Geometry.Triangles[TriIdx * 3 + 2]]) / 3.f;
+			const int32 BlockX = FMath::Clamp(FMath::FloorToInt((Centroid.X + LocalExtent) * NumBlocksPerSide / (Key.N - 1)), 0, NumBlocksPerSide - 1);
+			const int32 BlockY = FMath::Clamp(FMath::FloorToInt((Centroid.Y + LocalExtent) * NumBlocksPerSide / (Key.N - 1)), 0, NumBlocksPerSide - 1);
+			BlockTriangles[BlockY * NumBlocksPerSide + BlockX].Append(&Geometry.Triangles[TriIdx * 3], 3);
+		}
+
+		// Blocks are optimized on their own so each one stays a contiguous range
+		Geometry.Triangles.Reset();
+		for (TArray<int32>& Block : BlockTriangles)
+		{
+			if (Block.Num() == 0)
+			{
+				continue;
+			}
+
+			if (bOptimizeVertexCache)
+			{
+				OptimizeSectionTriangleOrder(Block, Geometry.Vertices.Num());
+			}
+			Geometry.BlockNumIndices.Add(Block.Num());
+			Geometry.Triangles.Append(Block);
+		}
+	});
+
+	// Every section goes into one vertex buffer and one index buffer, sections are index ranges of them.
+	// Each section owns a sub range of the vertices and its indices are relative to it, drawn with BaseVertexIndex,
+	// so indices stay 16 bit as long as every section has at most 65536 vertices. Sections overlap, but only the
+	// vertices of a same section are welded: welding across sections would let one reference vertices spread over
+	// the whole buffer, which at N=255 already needs 32 bit indices.
+	// Rings with a section too large for 16 bit indices anyway are rebuilt welding across every section, with a base of 0.
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector2D> UV;
+	TArray<FVector2D> UV1;
+	TArray<FVector2D> UV2;
+	TArray<FGeoClipmapGridPatch> Patches;
+	TMap<uint64, int32> WeldedVertices;
+	int32 NumIndexedVertices = 0;
+
+	const bool bBufferless = Key.VertexFormat == EGeoClipmapVertexFormat::Bufferless;
+
+	for (const bool bWeldAcrossSections : { false, true })
+	{
+		Vertices.Reset();
+		Triangles.Reset();
+		UV.Reset();
+		UV1.Reset();
+		UV2.Reset();
+		Patches.Reset();
+		WeldedVertices.Reset();
+		NumIndexedVertices = 0;
+
+		for (int32 SectionIndex = 0; SectionIndex < GeoClipmapRingSection::Num; SectionIndex++)
+		{
+			const FSectionGeometry& Geometry = SectionGeometries[SectionIndex];
+			const int32 FirstVertex = bWeldAcrossSections ? 0 : Vertices.Num();
+			if (!bWeldAcrossSections)
+			{
+				WeldedVertices.Reset();
+			}
+			SectionBlocks[SectionIndex].Reset();
+
+			TArray<int32> Remap;
+			Remap.SetNumUninitialized(Geometry.Vertices.Num());
+
+			if (bBufferless)
+			{
+				// Vertex ids are positions in the patches, sections are appended without welding
+				TArray<FGeoClipmapGridPatch> SectionPatches;
+				GetSectionGridPatches(Key, SectionIndex, SectionPatches);
+				for (FGeoClipmapGridPatch& Patch : SectionPatches)
+				{
+					Patch.FirstVertex += FirstVertex;
+					Patches.Add(Patch);
+				}
+			}
+
+			for (int32 VertIdx = 0; VertIdx < Geometry.Vertices.Num(); VertIdx++)
+			{
+				const FVector& Vertex = Geometry.Vertices[VertIdx];
+
+				if (!bBufferless)
+				{
+					const uint64 WeldKey = (uint64)(uint16)FMath::RoundToInt(Vertex.X) | (uint64)(uint16)FMath::RoundToInt(Vertex.Y) << 16 | (uint64)GetCompactVertexFlags(Vertex, Geometry.UV2[VertIdx]) << 32;
+					if (const int32* Welded = WeldedVertices.Find(WeldKey))
+					{
+						Remap[VertIdx] = *Welded;
+						continue;
+					}
+					WeldedVertices.Add(WeldKey, Vertices.Num());
+				}
+
+				Remap[VertIdx] = Vertices.Num();
+				Vertices.Add(Vertex);
+				UV.Add(Geometry.UV[VertIdx]);
+				UV1.Add(Geometry.UV1[VertIdx]);
+				UV2.Add(Geometry.UV2[VertIdx]);
+			}
+
+			NumIndexedVertices = FMath::Max(NumIndexedVertices, Vertices.Num() - FirstVertex);
+
+			FGeoClipmapIndexRange& Range = SectionRanges[SectionIndex];
+			Range.BaseVertexIndex = FirstVertex;
+			Range.FirstIndex = Triangles.Num();
+			Range.NumIndices = Geometry.Triangles.Num();
+			Range.MinVertexIndex = MAX_int32;
+			Range.MaxVertexIndex = 0;
+			Range.LocalBox.Init();
+
+			for (int32 NumBlockIndices : Geometry.BlockNumIndices)
+			{
+				FGeoClipmapIndexRange& Block = SectionBlocks[SectionIndex].AddDefaulted_GetRef();
+				Block.BaseVertexIndex = FirstVertex;
+				Block.FirstIndex = Triangles.Num();
+				Block.NumIndices = NumBlockIndices;
+				Block.MinVertexIndex = MAX_int32;
+				Block.MaxVertexIndex = 0;
+
+				for (int32 IndexIdx = Block.FirstIndex - Range.FirstIndex; IndexIdx < Block.FirstIndex - Range.FirstIndex + NumBlockIndices; IndexIdx++)
+				{
+					const int32 WeldedIndex = Remap[Geometry.Triangles[IndexIdx]];
+					Triangles.Add(WeldedIndex - FirstVertex);
+
+					Block.MinVertexIndex = FMath::Min(Block.MinVertexIndex, WeldedIndex - FirstVertex);
+					Block.MaxVertexIndex = FMath::Max(Block.MaxVertexIndex, WeldedIndex - FirstVertex);
+					Block.LocalBox += Vertices[WeldedIndex];
+				}
+
+				Range.MinVertexIndex = FMath::Min(Range.MinVertexIndex, Block.MinVertexIndex);
+				Range.MaxVertexIndex = FMath::Max(Range.MaxVertexIndex, Block.MaxVertexIndex);
+				Range.LocalBox += Block.LocalBox;
+			}
+
+			if (Range.NumIndices == 0)
+			{
+				Range.MinVertexIndex = 0;
+			}
+		}
+
+		if (bBufferless || NumIndexedVertices <= MAX_uint16 + 1)
+		{
+			break;
+		}
+	}
+
+	TSharedPtr<FGeoClipmapSharedSection, ESPMode::ThreadSafe> Shared = MakeShared<FGeoClipmapSharedSection, ESPMode::ThreadSafe>();
+	switch (Key.VertexFormat)
+	{
+	case EGeoClipmapVertexFormat::Compact:
+		FillCompactSection(Shared->Section, Vertices, Triangles, NumIndexedVertices, UV2, Key.VerticalJitter);
+		break;
+	case EGeoClipmapVertexFormat::Bufferless:
+		FillBufferlessSection(Shared->Section, Patches, Key.VerticalJitter, Vertices, Triangles, NumIndexedVertices);
+		break;
+	default:
+		FillSection(Shared->Section, Vertices, Triangles, NumIndexedVertices, UV, UV1, UV2);
+		break;
+	}
+	Mesh = Shared;
+}
+
+bool FGeoClipmapRingGeometry::OptimizeSectionTriangleOrder(TArray<int32>& Triangles, int32 NumVertices)
+{
+	TArray<int32> Optimized = Triangles;
+	GeoClipmapVertexCache::OptimizeTriangleOrder(Optimized, NumVertices);
+
+	// Small sections already fit in the cache in grid order, keep whichever order transforms less
+	if (GeoClipmapVertexCache::ComputeACMR(Optimized, NumVertices, ReferenceCacheSize) < GeoClipmapVertexCache::ComputeACMR(Triangles, NumVertices, ReferenceCacheSize))
+	{
+		Triangles = MoveTemp(Optimized);
+		return true;
+	}
+	return false;
+}
+
+void FGeoClipmapRingGeometry::CreateGridMeshWelded(int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs, TArray<FVector2D>& UV1s, TArray<FVector2D>& UV2s, float GridSpacing_, const FVector& Offset, uint8 StitchProfil, float VerticalJitter)
+{
+	if (NumX < 2 || NumY < 2)
+		return;
+
+	const int32 IDOffset = Vertices.Num();
+	const int32 NumVertices = IDOffset + NumX * NumY;
+
+	Vertices.SetNumUninitialized(NumVertices);
+	UVs.SetNumUninitialized(NumVertices);
+	UV1s.SetNumUninitialized(NumVertices);
+	UV2s.SetNumUninitialized(NumVertices);
+
+	FVector2D Extent = FVector2D(Offset.X,Offset.Y);
+
+	int32 VertexIndex = IDOffset;
+	for (int i = 0; i < NumY; i++)
+	{
+		for (int j = 0; j < NumX; j++, VertexIndex++)
+		{
+			FVector PosVertex = FVector((float)j * GridSpacing_ + Extent.X, (float)i * GridSpacing_ + Extent.Y, 0);
+
+			Vertices[VertexIndex] = PosVertex + FVector(0.f,0.f,1.f)*VerticalJitter * ((i+j)%2==0?1.f:-1.f);
+
+			UVs[VertexIndex] = FVector2D(FMath::Frac(PosVertex.X/400000.f), FMath::Frac(PosVertex.Y/400000.f));
+
+			UV1s[VertexIndex] = FVector2D(PosVertex.X/GridSpacing_, PosVertex.Y/GridSpacing_);
+
+			UV2s[VertexIndex] = FVector2D((i>0 && i<NumY-1)&&(j>0 && j<NumX-1)?1.f:0.f,0.f);
+		}
+	}
+
+	GeoClipmapGridIndices::Append(NumX, NumY, StitchProfil, IDOffset, Triangles);
+}
+
+static void GeoClipmapVertexCacheReport(const TArray<FString>& Args)
+{
+	const int32 NValues[] = { 511, 255, 127, 63, 31, 15 };
+	const uint8 StitchProfile = 1 << 3 | 1 << 2 | 1 << 1 | 1;
+	const TCHAR* SectionNames[GeoClipmapRingSection::Num] = { TEXT("FullRing"), TEXT("RingWithHole"), TEXT("InteriorBotLeft"), TEXT("InteriorTopLeft"), TEXT("InteriorBotRight"), TEXT("InteriorTopRight") };
+
+	for (int32 N : NValues)
+	{
+		GeoClipmapGridIndices::FScopedTables ScopedGridTables;
+
+		for (int32 SectionIndex = 0; SectionIndex < GeoClipmapRingSection::Num; SectionIndex++)
+		{
+			TArray<FVector> Vertices;
+			TArray<int32> Triangles;
+			TArray<FVector2D> UV;
+			TArray<FVector2D> UV1;
+			TArray<FVector2D> UV2;
+
+			FGeoClipmapRingGeometry::CreateSectionGeometry(FGeoClipmapRingGeometryKey(N, StitchProfile, 0.f), SectionIndex, Triangles, Vertices, UV, UV1, UV2);
+
+			const int32 NumVertices = Vertices.Num();
+			const float GridACMR = GeoClipmapVertexCache::ComputeACMR(Triangles, NumVertices, FGeoClipmapRingGeometry::ReferenceCacheSize);
+			const float GridATVR = GeoClipmapVertexCache::ComputeATVR(Triangles, NumVertices, FGeoClipmapRingGeometry::ReferenceCacheSize);
+
+			const bool bOptimized = FGeoClipmapRingGeometry::OptimizeSectionTriangleOrder(Triangles, NumVertices);
+
+			UE_LOG(LogGeoClipProceduralComponent, Display, TEXT("GeoClipmap vertex cache N %d %s : ACMR %.3f -> %.3f, ATVR %.3f -> %.3f%s"),
+				N, SectionNames[SectionIndex],
+				GridACMR, GeoClipmapVertexCache::ComputeACMR(Triangles, NumVertices, FGeoClipmapRingGeometry::ReferenceCacheSize),
+				GridATVR, GeoClipmapVertexCache::ComputeATVR(Triangles, NumVertices, FGeoClipmapRingGeometry::ReferenceCacheSize),
+				bOptimized ? TEXT("") : TEXT(" (grid order kept)"));
+		}
+	}
+}
+
+static FAutoConsoleCommand CmdGeoClipmapVertexCacheReport(
+	TEXT("GeoClipmap.VertexCacheReport"),
+	TEXT("Log the ACMR and ATVR of every clipmap ring section for every N, in grid order and after the vertex cache optimization."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&GeoClipmapVertexCacheReport));
@@ -0,0 +1,283 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "GeoClipmapVertexCache.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GGeoClipmapOptimizeVertexCache = 1;
+static FAutoConsoleVariableRef CVarGeoClipmapOptimizeVertexCache(
+	TEXT("GeoClipmap.OptimizeVertexCache"),
+	GGeoClipmapOptimizeVertexCache,
+	TEXT("1: Reorder the triangles of clipmap ring sections for post-transform vertex cache reuse; 0: Keep the row-major grid order. Applies to ring geometries built afterwards."));
+
+namespace GeoClipmapVertexCachePrivate
+{
+	// Forsyth's reference tuning, cache size is the simulated LRU size not the hardware one
+	const int32 MaxCacheSize = 32;
+	const float CacheDecayPower = 1.5f;
+	const float LastTriScore = 0.75f;
+	const float ValenceBoostScale = 2.0f;
+	const float ValenceBoostPower = 0.5f;
+	const int32 MaxPrecomputedValence = 32;
+
+	struct FScoreTables
+	{
+		float Cache[MaxCacheSize];
+		float Valence[MaxPrecomputedValence];
+
+		FScoreTables()
+		{
+			for (int32 CachePosition = 0; CachePosition < MaxCacheSize; CachePosition++)
+			{
+				if (CachePosition < 3)
+				{
+					// The three vertices of the last triangle get a fixed score so it is not favoured too much
+					Cache[CachePosition] = LastTriScore;
+				}
+				else
+				{
+					const float Scaler = 1.f / (MaxCacheSize - 3);
+					Cache[CachePosition] = FMath::Pow(1.f - (CachePosition - 3) * Scaler, CacheDecayPower);
+				}
+			}
+
+			Valence[0] = 0.f;
+			for (int32 Remaining = 1; Remaining < MaxPrecomputedValence; Remaining++)
+			{
+				Valence[Remaining] = ValenceBoostScale * FMath::Pow((float)Remaining, -ValenceBoostPower);
+			}
+		}
+	};
+
+	static float VertexScore(const FScoreTables& Tables, int32 CachePosition, int32 RemainingTriangles)
+	{
+		if (RemainingTriangles == 0)
+		{
+			return -1.f;
+		}
+
+		float Score = CachePosition >= 0 ? Tables.Cache[CachePosition] : 0.f;
+
+		// Boost vertices with few triangles left so lone triangles are not left behind
+		Score += RemainingTriangles < MaxPrecomputedValence ? Tables.Valence[RemainingTriangles] : ValenceBoostScale * FMath::Pow((float)RemainingTriangles, -ValenceBoostPower);
+
+		return Score;
+	}
+
+	/** FIFO cache simulation, returns the number of transformed vertices */
+	static int32 CountCacheMisses(const TArray<int32>& Triangles, int32 NumVertices, int32 CacheSize)
+	{
+		// A vertex stays in the cache until CacheSize other vertices are loaded after it
+		TArray<int32> LoadedAt;
+		LoadedAt.Init(-CacheSize - 1, NumVertices);
+
+		int32 Misses = 0;
+		for (int32 Index : Triangles)
+		{
+			if (Misses - LoadedAt[Index] > CacheSize)
+			{
+				LoadedAt[Index] = Misses;
+				Misses++;
+			}
+		}
+		return Misses;
+	}
+}
+
+bool GeoClipmapVertexCache::IsOptimizationEnabled()
+{
+	return GGeoClipmapOptimizeVertexCache != 0;
+}
+
+void GeoClipmapVertexCache::OptimizeTriangleOrder(TArray<int32>& Triangles, int32 NumVertices)
+{
+	using namespace GeoClipmapVertexCachePrivate;
+
+	static const FScoreTables Tables;
+
+	const int32 NumTriangles = Triangles.Num() / 3;
+	if (NumTriangles < 2 || NumVertices <= 0)
+	{
+		return;
+	}
+
+	// Vertex to triangles adjacency, the first Remaining[Vertex] entries are the triangles still to emit
+	TArray<int32> Remaining;
+	Remaining.SetNumZeroed(NumVertices);
+	for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+	{
+		Remaining[Triangles[Index]]++;
+	}
+
+	TArray<int32> AdjacencyOffset;
+	AdjacencyOffset.SetNumUninitialized(NumVertices + 1);
+	AdjacencyOffset[0] = 0;
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		AdjacencyOffset[Vertex + 1] = AdjacencyOffset[Vertex] + Remaining[Vertex];
+	}
+
+	TArray<int32> Adjacency;
+	Adjacency.SetNumUninitialized(NumTriangles * 3);
+	{
+		TArray<int32> Fill;
+		Fill.SetNumZeroed(NumVertices);
+		for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const int32 Vertex = Triangles[Triangle * 3 + Corner];
+				Adjacency[AdjacencyOffset[Vertex] + Fill[Vertex]++] = Triangle;
+			}
+		}
+	}
+
+	TArray<int32> CachePosition;
+	CachePosition.Init(-1, NumVertices);
+
+	TArray<float> Score;
+	Score.SetNumUninitialized(NumVertices);
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		Score[Vertex] = VertexScore(Tables, -1, Remaining[Vertex]);
+	}
+
+	TArray<bool> Emitted;
+	Emitted.Init(false, NumTriangles);
+
+	int32 BestTriangle = -1;
+	float BestScore = -1.f;
+	for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+	{
+		const float TriangleScore = Score[Triangles[Triangle * 3]] + Score[Triangles[Triangle * 3 + 1]] + Score[Triangles[Triangle * 3 + 2]];
+		if (TriangleScore > BestScore)
+		{
+			BestScore = TriangleScore;
+			BestTriangle = Triangle;
+		}
+	}
+
+	TArray<int32> Output;
+	Output.SetNumUninitialized(NumTriangles * 3);
+
+	int32 Cache[MaxCacheSize + 3];
+	int32 CacheCount = 0;
+	int32 NextUnemitted = 0;
+
+	for (int32 OutTriangle = 0; OutTriangle < NumTriangles; OutTriangle++)
+	{
+		if (BestTriangle < 0)
+		{
+			// Nothing adjacent to the cache is left, continue with the next triangle in input order
+			while (Emitted[NextUnemitted])
+			{
+				NextUnemitted++;
+			}
+			BestTriangle = NextUnemitted;
+		}
+
+		const int32* Corners = &Triangles[BestTriangle * 3];
+		Output[OutTriangle * 3 + 0] = Corners[0];
+		Output[OutTriangle * 3 + 1] = Corners[1];
+		Output[OutTriangle * 3 + 2] = Corners[2];
+		Emitted[BestTriangle] = true;
+
+		// Remove the triangle from its vertices adjacency
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const int32 Vertex = Corners[Corner];
+			int32* VertexTriangles = &Adjacency[AdjacencyOffset[Vertex]];
+			const int32 Last = Remaining[Vertex] - 1;
+			for (int32 Slot = 0; Slot <= Last; Slot++)
+			{
+				if (VertexTriangles[Slot] == BestTriangle)
+				{
+					VertexTriangles[Slot] = VertexTriangles[Last];
+					VertexTriangles[Last] = BestTriangle;
+					break;
+				}
+			}
+			Remaining[Vertex] = Last;
+		}
+
+		// Move the triangle vertices at the front of the LRU cache
+		int32 NewCache[MaxCacheSize + 3];
+		int32 NewCacheCount = 0;
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			NewCache[NewCacheCount++] = Corners[Corner];
+		}
+		for (int32 Slot = 0; Slot < CacheCount; Slot++)
+		{
+			const int32 Vertex = Cache[Slot];
+			if (Vertex != Corners[0] && Vertex != Corners[1] && Vertex != Corners[2])
+			{
+				NewCache[NewCacheCount++] = Vertex;
+			}
+		}
+
+		// Rescore the cache, vertices pushed out of it lose their cache score
+		for (int32 Slot = 0; Slot < NewCacheCount; Slot++)
+		{
+			const int32 Vertex = NewCache[Slot];
+			CachePosition[Vertex] = Slot < MaxCacheSize ? Slot : -1;
+			Score[Vertex] = VertexScore(Tables, CachePosition[Vertex], Remaining[Vertex]);
+		}
+
+		// Only triangles touching the cache changed score, the best one is among them
+		BestTriangle = -1;
+		BestScore = -1.f;
+		for (int32 Slot = 0; Slot < NewCacheCount; Slot++)
+		{
+			const int32 Vertex = NewCache[Slot];
+			const int32* VertexTriangles = &Adjacency[AdjacencyOffset[Vertex]];
+			for (int32 Adjacent = 0; Adjacent < Remaining[Vertex]; Adjacent++)
+			{
+				const int32 Triangle = VertexTriangles[Adjacent];
+				const float NewScore = Score[Triangles[Triangle * 3]] + Score[Triangles[Triangle * 3 + 1]] + Score[Triangles[Triangle * 3 + 2]];
+				if (NewScore > BestScore)
+				{
+					BestScore = NewScore;
+					BestTriangle = Triangle;
+				}
+			}
+		}
+
+		CacheCount = FMath::Min(NewCacheCount, MaxCacheSize);
+		FMemory::Memcpy(Cache, NewCache, CacheCount * sizeof(int32));
+	}
+
+	Triangles.SetNum(NumTriangles * 3, false);
+	FMemory::Memcpy(Triangles.GetData(), Output.GetData(), NumTriangles * 3 * sizeof(int32));
+}
+
+float GeoClipmapVertexCache::ComputeACMR(const TArray<int32>& Triangles, int32 NumVertices, int32 CacheSize)
+{
+	const int32 NumTriangles = Triangles.Num() / 3;
+	if (NumTriangles == 0)
+	{
+		return 0.f;
+	}
+
+	return (float)GeoClipmapVertexCachePrivate::CountCacheMisses(Triangles, NumVertices, CacheSize) / NumTriangles;
+}
+
+float GeoClipmapVertexCache::ComputeATVR(const TArray<int32>& Triangles, int32 NumVertices, int32 CacheSize)
+{
+	TBitArray<> Referenced(false, NumVertices);
+	int32 NumReferenced = 0;
+	for (int32 Index : Triangles)
+	{
+		if (!Referenced[Index])
+		{
+			Referenced[Index] = true;
+			NumReferenced++;
+		}
+	}
+
+	if (NumReferenced == 0)
+	{
+		return 0.f;
+	}
+
+	return (float)GeoClipmapVertexCachePrivate::CountCacheMisses(Triangles, NumVertices, CacheSize) / NumReferenced;
+}
@@ -0,0 +1,24 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+*	Post-transform vertex cache helpers for clipmap sections.
+*	The triangle order is optimized with Tom Forsyth's linear-speed algorithm, vertices are left untouched.
+*/
+namespace GeoClipmapVertexCache
+{
+	/** GeoClipmap.OptimizeVertexCache, read when a ring geometry is built */
+	bool IsOptimizationEnabled();
+
+	/** Reorder the triangles of an indexed triangle list for vertex reuse */
+	void OptimizeTriangleOrder(TArray<int32>& Triangles, int32 NumVertices);
+
+	/** Average cache miss ratio, transformed vertices per triangle with a FIFO cache of CacheSize entries */
+	float ComputeACMR(const TArray<int32>& Triangles, int32 NumVertices, int32 CacheSize);
+
+	/** Average transform to vertex ratio, transformed vertices per referenced vertex with a FIFO cache of CacheSize entries */
+	float ComputeATVR(const TArray<int32>& Triangles, int32 NumVertices, int32 CacheSize);
+}
@@ -0,0 +1,180 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "Noise/GeoClipmapHeightProgram.h"
+
+namespace GeoClipmapHeightProgram
+{
+	/** Points evaluated together, each register component holds this many floats */
+	static constexpr int32 BatchSize = 256;
+
+	template<typename OpType>
+	static FORCEINLINE void Unary(const float* A, float* Out, int32 Num, OpType Op)
+	{
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Out[Index] = Op(A[Index]);
+		}
+	}
+
+	template<typename OpType>
+	static FORCEINLINE void Binary(const float* A, const float* B, float* Out, int32 Num, OpType Op)
+	{
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Out[Index] = Op(A[Index], B[Index]);
+		}
+	}
+
+	template<typename OpType>
+	static FORCEINLINE void Ternary(const float* A, const float* B, const float* C, float* Out, int32 Num, OpType Op)
+	{
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Out[Index] = Op(A[Index], B[Index], C[Index]);
+		}
+	}
+}
+
+void FGeoClipmapHeightProgram::Reset()
+{
+	Ops.Reset();
+	RegisterComponents.Reset();
+	Output = INDEX_NONE;
+}
+
+int32 FGeoClipmapHeightProgram::AddRegister(int32 NumComponents)
+{
+	return RegisterComponents.Add(FMath::Clamp(NumComponents, 1, 4));
+}
+
+void FGeoClipmapHeightProgram::EvaluateBatch(TArrayView<const double> X, TArrayView<const double> Y, double Z, TArrayView<float> OutValues) const
+{
+	using namespace GeoClipmapHeightProgram;
+
+	check(Y.Num() == X.Num() && OutValues.Num() == X.Num());
+
+	if (!IsValid())
+	{
+		for (float& Value : OutValues)
+		{
+			Value = 0.f;
+		}
+		return;
+	}
+
+	TArray<float> Registers;
+	Registers.SetNumUninitialized(RegisterComponents.Num() * 4 * BatchSize);
+
+	// Registers with less components than read are broadcast, as HLSL does with scalars
+	auto Component = [this, &Registers](int32 Register, int32 ComponentIdx) -> float*
+	{
+		return Registers.GetData() + (Register * 4 + FMath::Min(ComponentIdx, RegisterComponents[Register] - 1)) * BatchSize;
+	};
+
+	for (int32 First = 0; First < X.Num(); First += BatchSize)
+	{
+		const int32 Num = FMath::Min(BatchSize, X.Num() - First);
+
+		for (const FGeoClipmapHeightOp& Op : Ops)
+		{
+			const int32 NumComponents = RegisterComponents[Op.Result];
+
+			if (Op.Type == EGeoClipmapHeightOpType::Noise)
+			{
+				FGeoClipmapNoise::EvaluateUVBatch(Op.Noise,
+					MakeArrayView(Component(Op.A, 0), Num), MakeArrayView(Component(Op.A, 1), Num), MakeArrayView(Component(Op.A, 2), Num),
+					MakeArrayView(Component(Op.Result, 0), Num));
+				continue;
+			}
+
+			for (int32 ComponentIdx = 0; ComponentIdx < NumComponents; ComponentIdx++)
+			{
+				float* Out = Component(Op.Result, ComponentIdx);
+				const float* A = Op.A != INDEX_NONE ? Component(Op.A, ComponentIdx) : nullptr;
+				const float* B = Op.B != INDEX_NONE ? Component(Op.B, ComponentIdx) : nullptr;
+				const float* C = Op.C != INDEX_NONE ? Component(Op.C, ComponentIdx) : nullptr;
+
+				switch (Op.Type)
+				{
+				case EGeoClipmapHeightOpType::Constant:
+				{
+					const float Value = Op.Value.Component(ComponentIdx);
+					for (int32 Index = 0; Index < Num; Index++)
+					{
+						Out[Index] = Value;
+					}
+					break;
+				}
+				case EGeoClipmapHeightOpType::WorldPosition:
+					for (int32 Index = 0; Index < Num; Index++)
+					{
+						Out[Index] = ComponentIdx == 0 ? (float)X[First + Index] : ComponentIdx == 1 ? (float)Y[First + Index] : (float)Z;
+					}
+					break;
+				case EGeoClipmapHeightOpType::Add:
+					Binary(A, B, Out, Num, [](float L, float R) { return L + R; });
+					break;
+				case EGeoClipmapHeightOpType::Subtract:
+					Binary(A, B, Out, Num, [](float L, float R) { return L - R; });
+					break;
+				case EGeoClipmapHeightOpType::Multiply:
+					Binary(A, B, Out, Num, [](float L, float R) { return L * R; });
+					break;
+				case EGeoClipmapHeightOpType::Divide:
+					Binary(A, B, Out, Num, [](float L, float R) { return L / R; });
+					break;
+				case EGeoClipmapHeightOpType::Min:
+					Binary(A, B, Out, Num, [](float L, float R) { return FMath::Min(L, R); });
+					break;
+				case EGeoClipmapHeightOpType::Max:
+					Binary(A, B, Out, Num, [](float L, float R) { return FMath::Max(L, R); });
+					break;
+				case EGeoClipmapHeightOpType::Power:
+					Binary(A, B, Out, Num, [](float L, float R) { return FMath::Pow(FMath::Max(L, 0.f), R); });
+					break;
+				case EGeoClipmapHeightOpType::Abs:
+					Unary(A, Out, Num, [](float V) { return FMath::Abs(V); });
+					break;
+				case EGeoClipmapHeightOpType::OneMinus:
+					Unary(A, Out, Num, [](float V) { return 1.f - V; });
+					break;
+				case EGeoClipmapHeightOpType::Floor:
+					Unary(A, Out, Num, [](float V) { return FMath::FloorToFloat(V); });
+					break;
+				case EGeoClipmapHeightOpType::Frac:
+					Unary(A, Out, Num, [](float V) { return V - FMath::FloorToFloat(V); });
+					break;
+				case EGeoClipmapHeightOpType::Saturate:
+					Unary(A, Out, Num, [](float V) { return FMath::Clamp(V, 0.f, 1.f); });
+					break;
+				case EGeoClipmapHeightOpType::Sine:
+					Unary(A, Out, Num, [](float V) { return FMath::Sin(V); });
+					break;
+				case EGeoClipmapHeightOpType::Cosine:
+					Unary(A, Out, Num, [](float V) { return FMath::Cos(V); });
+					break;
+				case EGeoClipmapHeightOpType::Lerp:
+					Ternary(A, B, C, Out, Num, [](float L, float R, float Alpha) { return L + Alpha * (R - L); });
+					break;
+				case EGeoClipmapHeightOpType::Clamp:
+					Ternary(A, B, C, Out, Num, [](float V, float Low, float High) { return FMath::Min(FMath::Max(V, Low), High); });
+					break;
+				case EGeoClipmapHeightOpType::Swizzle:
+					FMemory::Memcpy(Out, Component(Op.A, (Op.Swizzle >> (ComponentIdx * 2)) & 3), Num * sizeof(float));
+					break;
+				case EGeoClipmapHeightOpType::Append:
+				{
+					const int32 NumComponentsA = RegisterComponents[Op.A];
+					const float* Source = ComponentIdx < NumComponentsA ? Component(Op.A, ComponentIdx) : Component(Op.B, ComponentIdx - NumComponentsA);
+					FMemory::Memcpy(Out, Source, Num * sizeof(float));
+					break;
+				}
+				default:
+					break;
+				}
+			}
+		}
+
+		FMemory::Memcpy(OutValues.GetData() + First, Component(Output, 0), Num * sizeof(float));
+	}
+}
@@ -0,0 +1,565 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "GeoClipmapMaterialTranslator.h"
+
+#if WITH_EDITOR
+
+#include "Materials/MaterialFunctionInterface.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialExpressionAbs.h"
+#include "Materials/MaterialExpressionAdd.h"
+#include "Materials/MaterialExpressionAppendVector.h"
+#include "Materials/MaterialExpressionClamp.h"
+#include "Materials/MaterialExpressionCollectionParameter.h"
+#include "Materials/MaterialExpressionComponentMask.h"
+#include "Materials/MaterialExpressionConstant.h"
+#include "Materials/MaterialExpressionConstant2Vector.h"
+#include "Materials/MaterialExpressionConstant3Vector.h"
+#include "Materials/MaterialExpressionConstant4Vector.h"
+#include "Materials/MaterialExpressionCosine.h"
+#include "Materials/MaterialExpressionCustom.h"
+#include "Materials/MaterialExpressionDivide.h"
+#include "Materials/MaterialExpressionFloor.h"
+#include "Materials/MaterialExpressionFrac.h"
+#include "Materials/MaterialExpressionFunctionInput.h"
+#include "Materials/MaterialExpressionFunctionOutput.h"
+#include "Materials/MaterialExpressionLinearInterpolate.h"
+#include "Materials/MaterialExpressionMaterialFunctionCall.h"
+#include "Materials/MaterialExpressionMax.h"
+#include "Materials/MaterialExpressionMin.h"
+#include "Materials/MaterialExpressionMultiply.h"
+#include "Materials/MaterialExpressionOneMinus.h"
+#include "Materials/MaterialExpressionPower.h"
+#include "Materials/MaterialExpressionSaturate.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionSine.h"
+#include "Materials/MaterialExpressionSubtract.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+#include "Materials/MaterialExpressionWorldPosition.h"
+
+namespace GeoClipmapMaterialTranslator
+{
+	/** Nested function calls deeper than this are treated as a loop */
+	static constexpr int32 MaxCallDepth = 32;
+
+	/** Custom node of a noise material function shipped in Content/BP/Noise/ImprovedPerlin */
+	struct FKnownNoiseCode
+	{
+		/** FCrc::StrCrc32 and length of the exact Code */
+		uint32 Crc;
+		int32 Len;
+		EGeoClipmapNoiseType Type;
+		bool bAddsOffset;
+	};
+
+	static const FKnownNoiseCode KnownNoiseCodes[] =
+	{
+		{ 0x67e88c64, 123, EGeoClipmapNoiseType::FBM, true },				// MF_ImprovedPerlin_FBM
+		{ 0xad49fe32, 229, EGeoClipmapNoiseType::FBM_1TimeWarped, true },	// MF_ImprovedPerlin_FBM_1time_Warped
+		{ 0x8a3367f6, 464, EGeoClipmapNoiseType::FBM_2TimesWarped, true },	// MF_ImprovedPerlin_FBM_2TimesWarped, MF_ImprovedPerlin
+		{ 0x2f25e31d, 125, EGeoClipmapNoiseType::Ridged, false },			// MF_ImprovedPerlin_ridged
+		{ 0xb474719a, 120, EGeoClipmapNoiseType::Turbulence, false },		// MF_ImprovedPerlin_turbulence
+	};
+
+	/** Noise evaluated by the Custom node Code, only the exact code of the shipped noise functions is known, an edited copy may compute anything */
+	static bool GetNoiseType(const FString& Code, EGeoClipmapNoiseType& OutType, bool& bOutAddsOffset)
+	{
+		const uint32 Crc = FCrc::StrCrc32(*Code);
+		for (const FKnownNoiseCode& Known : KnownNoiseCodes)
+		{
+			if (Known.Crc == Crc && Known.Len == Code.Len())
+			{
+				OutType = Known.Type;
+				bOutAddsOffset = Known.bAddsOffset;
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+bool FGeoClipmapMaterialTranslator::Translate(UMaterialFunctionInterface* Function, FGeoClipmapHeightProgram& OutProgram, FString& OutError)
+{
+	OutProgram.Reset();
+
+	if (!Function)
+	{
+		OutError = TEXT("No material function");
+		return false;
+	}
+
+	FGeoClipmapMaterialTranslator Translator(OutProgram);
+	const int32 Output = Translator.TranslateFunction(Function, 0, TMap<const UMaterialExpression*, int32>());
+
+	if (Output == INDEX_NONE || !Translator.Error.IsEmpty())
+	{
+		OutError = Translator.Error.IsEmpty() ? FString::Printf(TEXT("%s has no output"), *Function->GetName()) : Translator.Error;
+		OutProgram.Reset();
+		return false;
+	}
+
+	OutProgram.Output = Output;
+	return true;
+}
+
+int32 FGeoClipmapMaterialTranslator::Fail(const FString& InError)
+{
+	// Keep the first error, the others follow from it
+	if (Error.IsEmpty())
+	{
+		Error = InError;
+	}
+	return INDEX_NONE;
+}
+
+int32 FGeoClipmapMaterialTranslator::TranslateInput(const FExpressionInput& Input)
+{
+	const FExpressionInput Traced = Input.GetTracedInput();
+	if (!Traced.Expression)
+	{
+		return Fail(TEXT("Unconnected input"));
+	}
+
+	const int32 Register = TranslateExpression(Traced.Expression, Traced.OutputIndex);
+	if (Register == INDEX_NONE || !Traced.Mask)
+	{
+		return Register;
+	}
+
+	TArray<int32> Components;
+	const int32 Masks[4] = { Traced.MaskR, Traced.MaskG, Traced.MaskB, Traced.MaskA };
+	for (int32 ComponentIdx = 0; ComponentIdx < 4; ComponentIdx++)
+	{
+		if (Masks[ComponentIdx])
+		{
+			Components.Add(ComponentIdx);
+		}
+	}
+
+	return AddSwizzle(Register, Components);
+}
+
+int32 FGeoClipmapMaterialTranslator::TranslateInputOr(const FExpressionInput& Input, float Constant)
+{
+	return Input.GetTracedInput().Expression ? TranslateInput(Input) : AddConstant(FLinearColor(Constant, 0.f, 0.f, 0.f), 1);
+}
+
+int32 FGeoClipmapMaterialTranslator::TranslateFunction(UMaterialFunctionInterface* Function, int32 OutputIndex, const TMap<const UMaterialExpression*, int32>& Inputs)
+{
+	if (!Function)
+	{
+		return Fail(TEXT("Function call without function"));
+	}
+	if (Contexts.Num() >= GeoClipmapMaterialTranslator::MaxCallDepth)
+	{
+		return Fail(FString::Printf(TEXT("%s calls itself"), *Function->GetName()));
+	}
+
+	TArray<FFunctionExpressionInput> FunctionInputs;
+	TArray<FFunctionExpressionOutput> FunctionOutputs;
+	Function->GetInputsAndOutputs(FunctionInputs, FunctionOutputs);
+
+	if (!FunctionOutputs.IsValidIndex(OutputIndex) || !FunctionOutputs[OutputIndex].ExpressionOutput)
+	{
+		return Fail(FString::Printf(TEXT("%s has no output %d"), *Function->GetName(), OutputIndex));
+	}
+
+	Contexts.AddDefaulted_GetRef().Inputs = Inputs;
+	const int32 Register = TranslateInput(FunctionOutputs[OutputIndex].ExpressionOutput->A);
+	Contexts.Pop();
+
+	return Register;
+}
+
+int32 FGeoClipmapMaterialTranslator::TranslateExpression(UMaterialExpression* Expression, int32 OutputIndex)
+{
+	const TPair<const UMaterialExpression*, int32> Key(Expression, OutputIndex);
+	if (const int32* Translated = Contexts.Last().Translated.Find(Key))
+	{
+		return *Translated;
+	}
+
+	int32 Register = INDEX_NONE;
+
+	if (const UMaterialExpressionConstant* Constant = Cast<UMaterialExpressionConstant>(Expression))
+	{
+		Register = AddConstant(FLinearColor(Constant->R, 0.f, 0.f, 0.f), 1);
+	}
+	else if (const UMaterialExpressionConstant2Vector* Constant2 = Cast<UMaterialExpressionConstant2Vector>(Expression))
+	{
+		Register = AddConstant(FLinearColor(Constant2->R, Constant2->G, 0.f, 0.f), 2);
+	}
+	else if (const UMaterialExpressionConstant3Vector* Constant3 = Cast<UMaterialExpressionConstant3Vector>(Expression))
+	{
+		Register = AddConstant(Constant3->Constant, 3);
+	}
+	else if (const UMaterialExpressionConstant4Vector* Constant4 = Cast<UMaterialExpressionConstant4Vector>(Expression))
+	{
+		Register = AddConstant(Constant4->Constant, 4);
+	}
+	else if (const UMaterialExpressionScalarParameter* Scalar = Cast<UMaterialExpressionScalarParameter>(Expression))
+	{
+		Register = AddConstant(FLinearColor(Scalar->DefaultValue, 0.f, 0.f, 0.f), 1);
+	}
+	else if (const UMaterialExpressionVectorParameter* Vector = Cast<UMaterialExpressionVectorParameter>(Expression))
+	{
+		Register = AddConstant(Vector->DefaultValue, 4);
+	}
+	else if (const UMaterialExpressionCollectionParameter* CollectionParam = Cast<UMaterialExpressionCollectionParameter>(Expression))
+	{
+		// Defaults of the collection, instances changed at runtime are not followed
+		const UMaterialParameterCollection* Collection = CollectionParam->Collection;
+		const FCollectionScalarParameter* ScalarParam = Collection ? Collection->GetScalarParameterByName(CollectionParam->ParameterName) : nullptr;
+		const FCollectionVectorParameter* VectorParam = Collection ? Collection->GetVectorParameterByName(CollectionParam->ParameterName) : nullptr;
+		if (ScalarParam)
+		{
+			Register = AddConstant(FLinearColor(ScalarParam->DefaultValue, 0.f, 0.f, 0.f), 1);
+		}
+		else if (VectorParam)
+		{
+			Register = AddConstant(VectorParam->DefaultValue, 4);
+		}
+		else
+		{
+			Register = Fail(FString::Printf(TEXT("Collection parameter %s not found"), *CollectionParam->ParameterName.ToString()));
+		}
+	}
+	else if (Cast<UMaterialExpressionWorldPosition>(Expression))
+	{
+		// Shared by every function, the op has no source
+		if (WorldPosition == INDEX_NONE)
+		{
+			WorldPosition = AddOp(EGeoClipmapHeightOpType::WorldPosition, 3, INDEX_NONE);
+		}
+		Register = WorldPosition;
+	}
+	else if (const UMaterialExpressionAdd* Add = Cast<UMaterialExpressionAdd>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Add, TranslateInputOr(Add->A, Add->ConstA), TranslateInputOr(Add->B, Add->ConstB));
+	}
+	else if (const UMaterialExpressionSubtract* Subtract = Cast<UMaterialExpressionSubtract>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Subtract, TranslateInputOr(Subtract->A, Subtract->ConstA), TranslateInputOr(Subtract->B, Subtract->ConstB));
+	}
+	else if (const UMaterialExpressionMultiply* Multiply = Cast<UMaterialExpressionMultiply>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Multiply, TranslateInputOr(Multiply->A, Multiply->ConstA), TranslateInputOr(Multiply->B, Multiply->ConstB));
+	}
+	else if (const UMaterialExpressionDivide* Divide = Cast<UMaterialExpressionDivide>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Divide, TranslateInputOr(Divide->A, Divide->ConstA), TranslateInputOr(Divide->B, Divide->ConstB));
+	}
+	else if (const UMaterialExpressionMin* Min = Cast<UMaterialExpressionMin>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Min, TranslateInputOr(Min->A, Min->ConstA), TranslateInputOr(Min->B, Min->ConstB));
+	}
+	else if (const UMaterialExpressionMax* Max = Cast<UMaterialExpressionMax>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Max, TranslateInputOr(Max->A, Max->ConstA), TranslateInputOr(Max->B, Max->ConstB));
+	}
+	else if (const UMaterialExpressionPower* Power = Cast<UMaterialExpressionPower>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Power, TranslateInput(Power->Base), TranslateInputOr(Power->Exponent, Power->ConstExponent));
+	}
+	else if (const UMaterialExpressionAbs* Abs = Cast<UMaterialExpressionAbs>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Abs, TranslateInput(Abs->Input));
+	}
+	else if (const UMaterialExpressionOneMinus* OneMinus = Cast<UMaterialExpressionOneMinus>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::OneMinus, TranslateInput(OneMinus->Input));
+	}
+	else if (const UMaterialExpressionFloor* Floor = Cast<UMaterialExpressionFloor>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Floor, TranslateInput(Floor->Input));
+	}
+	else if (const UMaterialExpressionFrac* Frac = Cast<UMaterialExpressionFrac>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Frac, TranslateInput(Frac->Input));
+	}
+	else if (const UMaterialExpressionSaturate* Saturate = Cast<UMaterialExpressionSaturate>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Saturate, TranslateInput(Saturate->Input));
+	}
+	else if (Cast<UMaterialExpressionSine>(Expression) || Cast<UMaterialExpressionCosine>(Expression))
+	{
+		const UMaterialExpressionSine* Sine = Cast<UMaterialExpressionSine>(Expression);
+		const UMaterialExpressionCosine* Cosine = Cast<UMaterialExpressionCosine>(Expression);
+		const float Period = Sine ? Sine->Period : Cosine->Period;
+
+		int32 Angle = TranslateInput(Sine ? Sine->Input : Cosine->Input);
+		if (Period > 0.f)
+		{
+			Angle = AddComponentWiseOp(EGeoClipmapHeightOpType::Multiply, Angle, AddConstant(FLinearColor(2.f * PI / Period, 0.f, 0.f, 0.f), 1));
+		}
+		Register = AddComponentWiseOp(Sine ? EGeoClipmapHeightOpType::Sine : EGeoClipmapHeightOpType::Cosine, Angle);
+	}
+	else if (const UMaterialExpressionLinearInterpolate* Lerp = Cast<UMaterialExpressionLinearInterpolate>(Expression))
+	{
+		Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Lerp,
+			TranslateInputOr(Lerp->A, Lerp->ConstA), TranslateInputOr(Lerp->B, Lerp->ConstB), TranslateInputOr(Lerp->Alpha, Lerp->ConstAlpha));
+	}
+	else if (const UMaterialExpressionClamp* Clamp = Cast<UMaterialExpressionClamp>(Expression))
+	{
+		const int32 Input = TranslateInput(Clamp->Input);
+		const int32 Low = TranslateInputOr(Clamp->Min, Clamp->MinDefault);
+		const int32 High = TranslateInputOr(Clamp->Max, Clamp->MaxDefault);
+
+		if (Clamp->ClampMode == CMODE_ClampMin)
+		{
+			Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Max, Input, Low);
+		}
+		else if (Clamp->ClampMode == CMODE_ClampMax)
+		{
+			Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Min, Input, High);
+		}
+		else
+		{
+			Register = AddComponentWiseOp(EGeoClipmapHeightOpType::Clamp, Input, Low, High);
+		}
+	}
+	else if (const UMaterialExpressionComponentMask* Mask = Cast<UMaterialExpressionComponentMask>(Expression))
+	{
+		TArray<int32> Components;
+		const bool Masks[4] = { !!Mask->R, !!Mask->G, !!Mask->B, !!Mask->A };
+		for (int32 ComponentIdx = 0; ComponentIdx < 4; ComponentIdx++)
+		{
+			if (Masks[ComponentIdx])
+			{
+				Components.Add(ComponentIdx);
+			}
+		}
+		Register = AddSwizzle(TranslateInput(Mask->Input), Components);
+	}
+	else if (const UMaterialExpressionAppendVector* Append = Cast<UMaterialExpressionAppendVector>(Expression))
+	{
+		const int32 A = TranslateInput(Append->A);
+		const int32 B = TranslateInput(Append->B);
+		if (Error.IsEmpty())
+		{
+			const int32 NumComponents = Program.RegisterComponents[A] + Program.RegisterComponents[B];
+			Register = NumComponents <= 4 ? AddOp(EGeoClipmapHeightOpType::Append, NumComponents, A, B) : Fail(TEXT("Append of more than 4 components"));
+		}
+	}
+	else if (const UMaterialExpressionMaterialFunctionCall* Call = Cast<UMaterialExpressionMaterialFunctionCall>(Expression))
+	{
+		TMap<const UMaterialExpression*, int32> Inputs;
+		for (const FFunctionExpressionInput& FunctionInput : Call->FunctionInputs)
+		{
+			if (FunctionInput.Input.GetTracedInput().Expression)
+			{
+				Inputs.Add(FunctionInput.ExpressionInput, TranslateInput(FunctionInput.Input));
+			}
+		}
+		if (Error.IsEmpty())
+		{
+			Register = TranslateFunction(Call->MaterialFunction, OutputIndex, Inputs);
+		}
+	}
+	else if (const UMaterialExpressionFunctionInput* FunctionInput = Cast<UMaterialExpressionFunctionInput>(Expression))
+	{
+		if (const int32* Wired = Contexts.Last().Inputs.Find(FunctionInput))
+		{
+			Register = *Wired;
+		}
+		else if (FunctionInput->Preview.GetTracedInput().Expression)
+		{
+			Register = TranslateInput(FunctionInput->Preview);
+		}
+		else
+		{
+			const int32 NumComponents[4] = { 1, 2, 3, 4 };
+			if (FunctionInput->InputType > FunctionInput_Vector4)
+			{
+				Register = Fail(FString::Printf(TEXT("Input %s is not a scalar or a vector"), *FunctionInput->InputName.ToString()));
+			}
+			else
+			{
+				const FLinearColor Preview((float)FunctionInput->PreviewValue.X, (float)FunctionInput->PreviewValue.Y, (float)FunctionInput->PreviewValue.Z, (float)FunctionInput->PreviewValue.W);
+				Register = AddConstant(Preview, NumComponents[FunctionInput->InputType]);
+			}
+		}
+	}
+	else if (const UMaterialExpressionFunctionOutput* FunctionOutput = Cast<UMaterialExpressionFunctionOutput>(Expression))
+	{
+		Register = TranslateInput(FunctionOutput->A);
+	}
+	else if (UMaterialExpressionCustom* Custom = Cast<UMaterialExpressionCustom>(Expression))
+	{
+		Register = TranslateCustom(Custom);
+	}
+	else
+	{
+		Register = Fail(FString::Printf(TEXT("%s is not supported"), *Expression->GetClass()->GetName()));
+	}
+
+	if (Register != INDEX_NONE)
+	{
+		Contexts.Last().Translated.Add(Key, Register);
+	}
+	return Register;
+}
+
+int32 FGeoClipmapMaterialTranslator::TranslateCustom(UMaterialExpressionCustom* Custom)
+{
+	FGeoClipmapNoiseLayer Noise;
+	bool bAddsOffset = false;
+	if (Custom->OutputType != CMOT_Float1 || !GeoClipmapMaterialTranslator::GetNoiseType(Custom->Code, Noise.Type, bAddsOffset))
+	{
+		return Fail(FString::Printf(TEXT("Custom node %s is not the code of an ImprovedPerlin noise function"), *Custom->GetName()));
+	}
+
+	// The UV input is already scaled, the other ones have to be the same for every point
+	Noise.PosScaling = 1.f;
+	Noise.GlobalOffset = 0.f;
+	Noise.Scale = 1.f;
+
+	int32 UV = INDEX_NONE;
+	for (const FCustomInput& Input : Custom->Inputs)
+	{
+		float* Setting = nullptr;
+		if (Input.InputName == TEXT("UV"))
+		{
+			UV = TranslateInput(Input.Input);
+			continue;
+		}
+		else if (Input.InputName == TEXT("Octaves"))
+		{
+			Setting = &Noise.Octave;
+		}
+		else if (Input.InputName == TEXT("lacunarity"))
+		{
+			Setting = &Noise.Lacunarity;
+		}
+		else if (Input.InputName == TEXT("gain"))
+		{
+			Setting = &Noise.Gain;
+		}
+		else if (Input.InputName == TEXT("offset"))
+		{
+			Setting = &Noise.Offset;
+		}
+		else
+		{
+			// Permutation textures, sampled through the noise tables
+			continue;
+		}
+
+		FLinearColor Value;
+		if (!GetConstant(TranslateInput(Input.Input), Value))
+		{
+			return Fail(FString::Printf(TEXT("Input %s of %s is not a constant or a parameter"), *Input.InputName.ToString(), *Custom->GetName()));
+		}
+		*Setting = Value.R;
+	}
+
+	if (UV == INDEX_NONE || !Error.IsEmpty())
+	{
+		return Fail(FString::Printf(TEXT("%s has no UV input"), *Custom->GetName()));
+	}
+
+	// FBM variants add it to the noise, Ridged uses it as its ridge offset
+	if (!bAddsOffset && Noise.Type != EGeoClipmapNoiseType::Ridged)
+	{
+		Noise.Offset = 0.f;
+	}
+
+	const int32 Register = AddOp(EGeoClipmapHeightOpType::Noise, 1, UV);
+	Program.Ops.Last().Noise = Noise;
+	return Register;
+}
+
+int32 FGeoClipmapMaterialTranslator::AddConstant(const FLinearColor& Value, int32 NumComponents)
+{
+	const int32 Register = AddOp(EGeoClipmapHeightOpType::Constant, NumComponents, INDEX_NONE);
+	Program.Ops.Last().Value = Value;
+	Constants.Add(Register, Value);
+	return Register;
+}
+
+int32 FGeoClipmapMaterialTranslator::AddOp(EGeoClipmapHeightOpType Type, int32 NumComponents, int32 A, int32 B, int32 C)
+{
+	FGeoClipmapHeightOp& Op = Program.Ops.AddDefaulted_GetRef();
+	Op.Type = Type;
+	Op.Result = Program.AddRegister(NumComponents);
+	Op.A = A;
+	Op.B = B;
+	Op.C = C;
+	return Op.Result;
+}
+
+int32 FGeoClipmapMaterialTranslator::AddComponentWiseOp(EGeoClipmapHeightOpType Type, int32 A, int32 B, int32 C)
+{
+	// One of the sources failed, the error is already set
+	if (!Error.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	// Scalars are broadcast, other sources have to match as HLSL would
+	int32 NumComponents = 1;
+	for (const int32 Source : { A, B, C })
+	{
+		if (Source == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const int32 SourceComponents = Program.RegisterComponents[Source];
+		if (SourceComponents != 1 && NumComponents != 1 && SourceComponents != NumComponents)
+		{
+			return Fail(FString::Printf(TEXT("Mismatched vector sizes %d and %d"), NumComponents, SourceComponents));
+		}
+		NumComponents = FMath::Max(NumComponents, SourceComponents);
+	}
+
+	return AddOp(Type, NumComponents, A, B, C);
+}
+
+int32 FGeoClipmapMaterialTranslator::AddSwizzle(int32 Source, const TArray<int32>& Components)
+{
+	if (Source == INDEX_NONE || Components.Num() == 0)
+	{
+		return Source;
+	}
+
+	bool bIdentity = Components.Num() == Program.RegisterComponents[Source];
+	int32 Swizzle = 0;
+	for (int32 ComponentIdx = 0; ComponentIdx < Components.Num(); ComponentIdx++)
+	{
+		bIdentity &= Components[ComponentIdx] == ComponentIdx;
+		Swizzle |= Components[ComponentIdx] << (ComponentIdx * 2);
+	}
+
+	if (bIdentity)
+	{
+		return Source;
+	}
+
+	const int32 Register = AddOp(EGeoClipmapHeightOpType::Swizzle, Components.Num(), Source);
+	Program.Ops.Last().Swizzle = Swizzle;
+	return Register;
+}
+
+bool FGeoClipmapMaterialTranslator::GetConstant(int32 Register, FLinearColor& OutValue) const
+{
+	if (const FLinearColor* Value = Constants.Find(Register))
+	{
+		OutValue = *Value;
+		return true;
+	}
+
+	// A single component picked out of a constant, as a collection parameter wired through a mask
+	for (const FGeoClipmapHeightOp& Op : Program.Ops)
+	{
+		if (Op.Result == Register && Op.Type == EGeoClipmapHeightOpType::Swizzle && Constants.Contains(Op.A))
+		{
+			OutValue = FLinearColor(Constants[Op.A].Component(Op.Swizzle & 3), 0.f, 0.f, 0.f);
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif
@@ -0,0 +1,64 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Noise/GeoClipmapHeightProgram.h"
+
+#if WITH_EDITOR
+
+class UMaterialExpression;
+class UMaterialFunctionInterface;
+struct FExpressionInput;
+
+/**
+*	Walks the expression graph of a height material function into a FGeoClipmapHeightProgram.
+*	Handles constants, parameter and collection defaults, world position, the common math nodes,
+*	function calls and the Custom nodes of the ImprovedPerlin functions. Anything else fails the translation.
+*/
+class FGeoClipmapMaterialTranslator
+{
+public:
+	/**
+	*	Translate the first output of Function.
+	*	@return false, with the reason in OutError, when the graph uses a node the program can't evaluate
+	*/
+	static bool Translate(UMaterialFunctionInterface* Function, FGeoClipmapHeightProgram& OutProgram, FString& OutError);
+
+private:
+	/** Function call being translated */
+	struct FCallContext
+	{
+		/** Register of each FunctionInput wired by the caller */
+		TMap<const UMaterialExpression*, int32> Inputs;
+		/** Register of each expression output already translated */
+		TMap<TPair<const UMaterialExpression*, int32>, int32> Translated;
+	};
+
+	explicit FGeoClipmapMaterialTranslator(FGeoClipmapHeightProgram& InProgram) : Program(InProgram) {}
+
+	int32 TranslateInput(const FExpressionInput& Input);
+	/** Input when connected, Constant otherwise */
+	int32 TranslateInputOr(const FExpressionInput& Input, float Constant);
+	int32 TranslateExpression(UMaterialExpression* Expression, int32 OutputIndex);
+	int32 TranslateFunction(UMaterialFunctionInterface* Function, int32 OutputIndex, const TMap<const UMaterialExpression*, int32>& Inputs);
+	int32 TranslateCustom(class UMaterialExpressionCustom* Custom);
+
+	int32 AddConstant(const FLinearColor& Value, int32 NumComponents);
+	int32 AddOp(EGeoClipmapHeightOpType Type, int32 NumComponents, int32 A, int32 B = INDEX_NONE, int32 C = INDEX_NONE);
+	/** Op whose result has as many components as its widest source */
+	int32 AddComponentWiseOp(EGeoClipmapHeightOpType Type, int32 A, int32 B = INDEX_NONE, int32 C = INDEX_NONE);
+	int32 AddSwizzle(int32 Source, const TArray<int32>& Components);
+	bool GetConstant(int32 Register, FLinearColor& OutValue) const;
+
+	int32 Fail(const FString& Error);
+
+	FGeoClipmapHeightProgram& Program;
+	TArray<FCallContext> Contexts;
+	/** Value of each register written by a Constant op */
+	TMap<int32, FLinearColor> Constants;
+	int32 WorldPosition = INDEX_NONE;
+	FString Error;
+};
+
+#endif
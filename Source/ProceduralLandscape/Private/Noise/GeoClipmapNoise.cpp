@@ -0,0 +1,501 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "Noise/GeoClipmapNoise.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && defined(__AVX2__)
+#define GEOCLIPMAP_NOISE_AVX2 1
+#include <immintrin.h>
+#else
+#define GEOCLIPMAP_NOISE_AVX2 0
+#endif
+
+namespace GeoClipmapNoise
+{
+	/** Points evaluated together, sized for the stack buffers of the batch path */
+	static constexpr int32 BatchSize = 256;
+
+	static const uint8 Permutation[256] =
+	{
+		151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+		140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+		247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+		57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+		74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+		60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+		65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+		200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+		52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+		207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+		119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+		129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+		218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+		81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+		184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+		222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+	};
+
+	/** T_permuTexture2d stores the permutation sRGB encoded in RGB while being sampled as linear, byte sampled for each value. Alpha is stored linear */
+	static const uint8 EncodedPermutation[256] =
+	{
+		0, 12, 21, 28, 33, 38, 42, 46, 49, 52, 55, 58, 61, 64, 66, 68,
+		71, 73, 75, 77, 79, 81, 83, 85, 86, 88, 90, 91, 93, 95, 96, 98,
+		99, 101, 102, 103, 105, 106, 108, 109, 110, 112, 113, 114, 115, 116, 118, 119,
+		120, 121, 122, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136,
+		137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 148, 149, 150, 151,
+		152, 153, 154, 155, 155, 156, 157, 158, 159, 160, 160, 161, 162, 163, 164, 164,
+		165, 166, 167, 167, 168, 169, 170, 171, 171, 172, 173, 173, 174, 175, 176, 176,
+		177, 178, 179, 179, 180, 181, 181, 182, 183, 183, 184, 185, 185, 186, 187, 187,
+		188, 189, 189, 190, 191, 191, 192, 193, 193, 194, 195, 195, 196, 196, 197, 198,
+		198, 199, 199, 200, 201, 201, 202, 202, 203, 204, 204, 205, 205, 206, 207, 207,
+		208, 208, 209, 210, 210, 211, 211, 212, 212, 213, 213, 214, 215, 215, 216, 216,
+		217, 217, 218, 218, 219, 220, 220, 221, 221, 222, 222, 223, 223, 224, 224, 225,
+		225, 226, 226, 227, 227, 228, 228, 229, 229, 230, 230, 231, 231, 232, 232, 233,
+		233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238, 239, 239, 240, 240, 241,
+		241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 246, 247, 247, 248, 248,
+		249, 249, 250, 250, 251, 251, 251, 252, 252, 253, 253, 254, 254, 255, 255, 255,
+	};
+
+	/** 16 gradients of the material functions, T_permGradTexture stores them through the same sRGB encoding */
+	static const int8 Gradients[16][3] =
+	{
+		{1,1,0}, {-1,1,0}, {1,-1,0}, {-1,-1,0},
+		{1,0,1}, {-1,0,1}, {1,0,-1}, {-1,0,-1},
+		{0,1,1}, {0,-1,1}, {0,1,-1}, {0,-1,-1},
+		{1,1,0}, {0,-1,1}, {-1,1,0}, {0,-1,-1},
+	};
+
+	/** Texels of the two noise textures, int32 and split per component to be gathered by the AVX2 path */
+	struct FTables
+	{
+		/** permutation[i], the hash of the perm2d texel coordinates */
+		int32 Perm[256];
+		/** permGrad texel that the RGB perm2d value permutation[i] lands on, once added to the Z cell */
+		int32 Texel[256];
+		/** Same for the alpha of perm2d */
+		int32 TexelAlpha[256];
+		float GradX[256];
+		float GradY[256];
+		float GradZ[256];
+
+		FTables()
+		{
+			// 0 decodes to -1, 255 to 1, 0.5 was encoded to 187 and decodes to 119/255
+			const float Decoded[3] = { -1.f, 119.f / 255.f, 1.f };
+
+			for (int32 Index = 0; Index < 256; Index++)
+			{
+				Perm[Index] = Permutation[Index];
+
+				// perm2d / 255 + Z / 256 is sampled in a 256 texels wide texture, the byte 255 wraps to the Z texel
+				const int32 Encoded = EncodedPermutation[Permutation[Index]];
+				Texel[Index] = Encoded == 255 ? 0 : Encoded;
+				TexelAlpha[Index] = Permutation[Index] == 255 ? 0 : Permutation[Index];
+
+				const int8* Gradient = Gradients[Permutation[Index] % 16];
+				GradX[Index] = Decoded[Gradient[0] + 1];
+				GradY[Index] = Decoded[Gradient[1] + 1];
+				GradZ[Index] = Decoded[Gradient[2] + 1];
+			}
+		}
+	};
+
+	static const FTables& GetTables()
+	{
+		static const FTables Tables;
+		return Tables;
+	}
+
+	static FORCEINLINE float Fade(float T)
+	{
+		return T * T * T * (T * (T * 6.f - 15.f) + 10.f);
+	}
+
+	static FORCEINLINE float Grad(const FTables& Tables, int32 Hash, float X, float Y, float Z)
+	{
+		Hash &= 255;
+		return Tables.GradX[Hash] * X + Tables.GradY[Hash] * Y + Tables.GradZ[Hash] * Z;
+	}
+
+	/** Optimized inoise() of the material functions */
+	static float Inoise(const FTables& Tables, float X, float Y, float Z)
+	{
+		const float FloorX = FMath::FloorToFloat(X);
+		const float FloorY = FMath::FloorToFloat(Y);
+		const float FloorZ = FMath::FloorToFloat(Z);
+		const int32 CellX = (int32)FloorX & 255;
+		const int32 CellY = (int32)FloorY & 255;
+		const int32 CellZ = (int32)FloorZ & 255;
+		X -= FloorX;
+		Y -= FloorY;
+		Z -= FloorZ;
+
+		const float U = Fade(X);
+		const float V = Fade(Y);
+		const float W = Fade(Z);
+
+		// perm2d texel of the cell, then the permGrad texel of each corner
+		const int32 A = Tables.Perm[CellX] + CellY;
+		const int32 B = Tables.Perm[(CellX + 1) & 255] + CellY;
+		const int32 AA = Tables.Texel[A & 255] + CellZ;
+		const int32 AB = Tables.Texel[(A + 1) & 255] + CellZ;
+		const int32 BA = Tables.Texel[B & 255] + CellZ;
+		const int32 BB = Tables.TexelAlpha[(B + 1) & 255] + CellZ;
+
+		return FMath::Lerp(
+			FMath::Lerp(
+				FMath::Lerp(Grad(Tables, AA, X, Y, Z), Grad(Tables, BA, X - 1.f, Y, Z), U),
+				FMath::Lerp(Grad(Tables, AB, X, Y - 1.f, Z), Grad(Tables, BB, X - 1.f, Y - 1.f, Z), U), V),
+			FMath::Lerp(
+				FMath::Lerp(Grad(Tables, AA + 1, X, Y, Z - 1.f), Grad(Tables, BA + 1, X - 1.f, Y, Z - 1.f), U),
+				FMath::Lerp(Grad(Tables, AB + 1, X, Y - 1.f, Z - 1.f), Grad(Tables, BB + 1, X - 1.f, Y - 1.f, Z - 1.f), U), V), W);
+	}
+
+#if GEOCLIPMAP_NOISE_AVX2
+	static FORCEINLINE __m256 LerpAVX2(__m256 A, __m256 B, __m256 T)
+	{
+		return _mm256_add_ps(A, _mm256_mul_ps(T, _mm256_sub_ps(B, A)));
+	}
+
+	static FORCEINLINE __m256 FadeAVX2(__m256 T)
+	{
+		const __m256 Poly = _mm256_add_ps(_mm256_mul_ps(T, _mm256_sub_ps(_mm256_mul_ps(T, _mm256_set1_ps(6.f)), _mm256_set1_ps(15.f))), _mm256_set1_ps(10.f));
+		return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(T, T), T), Poly);
+	}
+
+	static FORCEINLINE __m256 GradAVX2(const FTables& Tables, __m256i Hash, __m256 X, __m256 Y, __m256 Z)
+	{
+		Hash = _mm256_and_si256(Hash, _mm256_set1_epi32(255));
+		const __m256 GX = _mm256_i32gather_ps(Tables.GradX, Hash, 4);
+		const __m256 GY = _mm256_i32gather_ps(Tables.GradY, Hash, 4);
+		const __m256 GZ = _mm256_i32gather_ps(Tables.GradZ, Hash, 4);
+		return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(GX, X), _mm256_mul_ps(GY, Y)), _mm256_mul_ps(GZ, Z));
+	}
+
+	/** Inoise of 8 points */
+	static void InoiseAVX2(const FTables& Tables, const float* InX, const float* InY, const float* InZ, float* Out)
+	{
+		const __m256i Mask = _mm256_set1_epi32(255);
+		const __m256i One = _mm256_set1_epi32(1);
+		const __m256 OneF = _mm256_set1_ps(1.f);
+
+		__m256 X = _mm256_loadu_ps(InX);
+		__m256 Y = _mm256_loadu_ps(InY);
+		__m256 Z = _mm256_loadu_ps(InZ);
+		const __m256 FloorX = _mm256_floor_ps(X);
+		const __m256 FloorY = _mm256_floor_ps(Y);
+		const __m256 FloorZ = _mm256_floor_ps(Z);
+		const __m256i CellX = _mm256_and_si256(_mm256_cvttps_epi32(FloorX), Mask);
+		const __m256i CellY = _mm256_and_si256(_mm256_cvttps_epi32(FloorY), Mask);
+		const __m256i CellZ = _mm256_and_si256(_mm256_cvttps_epi32(FloorZ), Mask);
+		X = _mm256_sub_ps(X, FloorX);
+		Y = _mm256_sub_ps(Y, FloorY);
+		Z = _mm256_sub_ps(Z, FloorZ);
+
+		const __m256 U = FadeAVX2(X);
+		const __m256 V = FadeAVX2(Y);
+		const __m256 W = FadeAVX2(Z);
+
+		const __m256i A = _mm256_add_epi32(_mm256_i32gather_epi32(Tables.Perm, CellX, 4), CellY);
+		const __m256i B = _mm256_add_epi32(_mm256_i32gather_epi32(Tables.Perm, _mm256_and_si256(_mm256_add_epi32(CellX, One), Mask), 4), CellY);
+		const __m256i AA = _mm256_add_epi32(_mm256_i32gather_epi32(Tables.Texel, _mm256_and_si256(A, Mask), 4), CellZ);
+		const __m256i AB = _mm256_add_epi32(_mm256_i32gather_epi32(Tables.Texel, _mm256_and_si256(_mm256_add_epi32(A, One), Mask), 4), CellZ);
+		const __m256i BA = _mm256_add_epi32(_mm256_i32gather_epi32(Tables.Texel, _mm256_and_si256(B, Mask), 4), CellZ);
+		const __m256i BB = _mm256_add_epi32(_mm256_i32gather_epi32(Tables.TexelAlpha, _mm256_and_si256(_mm256_add_epi32(B, One), Mask), 4), CellZ);
+
+		const __m256 X1 = _mm256_sub_ps(X, OneF);
+		const __m256 Y1 = _mm256_sub_ps(Y, OneF);
+		const __m256 Z1 = _mm256_sub_ps(Z, OneF);
+
+		const __m256 Near = LerpAVX2(
+			LerpAVX2(GradAVX2(Tables, AA, X, Y, Z), GradAVX2(Tables, BA, X1, Y, Z), U),
+			LerpAVX2(GradAVX2(Tables, AB, X, Y1, Z), GradAVX2(Tables, BB, X1, Y1, Z), U), V);
+		const __m256 Far = LerpAVX2(
+			LerpAVX2(GradAVX2(Tables, _mm256_add_epi32(AA, One), X, Y, Z1), GradAVX2(Tables, _mm256_add_epi32(BA, One), X1, Y, Z1), U),
+			LerpAVX2(GradAVX2(Tables, _mm256_add_epi32(AB, One), X, Y1, Z1), GradAVX2(Tables, _mm256_add_epi32(BB, One), X1, Y1, Z1), U), V);
+
+		_mm256_storeu_ps(Out, LerpAVX2(Near, Far, W));
+	}
+#endif
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	static FORCEINLINE VectorRegister4Float LerpVector(const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& T)
+	{
+		return VectorMultiplyAdd(T, VectorSubtract(B, A), A);
+	}
+
+	static FORCEINLINE VectorRegister4Float FadeVector(const VectorRegister4Float& T)
+	{
+		const VectorRegister4Float Poly = VectorMultiplyAdd(T, VectorMultiplyAdd(T, VectorSetFloat1(6.f), VectorSetFloat1(-15.f)), VectorSetFloat1(10.f));
+		return VectorMultiply(VectorMultiply(VectorMultiply(T, T), T), Poly);
+	}
+
+	/** Inoise of 4 points, SSE and NEON have no gather so the corners are hashed per lane */
+	static void InoiseVector(const FTables& Tables, const float* InX, const float* InY, const float* InZ, float* Out)
+	{
+		VectorRegister4Float X = VectorLoad(InX);
+		VectorRegister4Float Y = VectorLoad(InY);
+		VectorRegister4Float Z = VectorLoad(InZ);
+		const VectorRegister4Float FloorX = VectorFloor(X);
+		const VectorRegister4Float FloorY = VectorFloor(Y);
+		const VectorRegister4Float FloorZ = VectorFloor(Z);
+		X = VectorSubtract(X, FloorX);
+		Y = VectorSubtract(Y, FloorY);
+		Z = VectorSubtract(Z, FloorZ);
+
+		alignas(16) float Cells[3][4];
+		VectorStoreAligned(FloorX, Cells[0]);
+		VectorStoreAligned(FloorY, Cells[1]);
+		VectorStoreAligned(FloorZ, Cells[2]);
+
+		// Gradient components of the 8 corners, per lane
+		alignas(16) float Corners[8][3][4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const int32 CellX = (int32)Cells[0][Lane] & 255;
+			const int32 CellY = (int32)Cells[1][Lane] & 255;
+			const int32 CellZ = (int32)Cells[2][Lane] & 255;
+
+			const int32 A = Tables.Perm[CellX] + CellY;
+			const int32 B = Tables.Perm[(CellX + 1) & 255] + CellY;
+			const int32 AA = Tables.Texel[A & 255] + CellZ;
+			const int32 AB = Tables.Texel[(A + 1) & 255] + CellZ;
+			const int32 BA = Tables.Texel[B & 255] + CellZ;
+			const int32 BB = Tables.TexelAlpha[(B + 1) & 255] + CellZ;
+			const int32 Hashes[8] = { AA, BA, AB, BB, AA + 1, BA + 1, AB + 1, BB + 1 };
+
+			for (int32 Corner = 0; Corner < 8; Corner++)
+			{
+				const int32 Hash = Hashes[Corner] & 255;
+				Corners[Corner][0][Lane] = Tables.GradX[Hash];
+				Corners[Corner][1][Lane] = Tables.GradY[Hash];
+				Corners[Corner][2][Lane] = Tables.GradZ[Hash];
+			}
+		}
+
+		const VectorRegister4Float OneF = VectorSetFloat1(1.f);
+		const VectorRegister4Float X1 = VectorSubtract(X, OneF);
+		const VectorRegister4Float Y1 = VectorSubtract(Y, OneF);
+		const VectorRegister4Float Z1 = VectorSubtract(Z, OneF);
+
+		auto CornerGrad = [&Corners](int32 Corner, const VectorRegister4Float& CX, const VectorRegister4Float& CY, const VectorRegister4Float& CZ)
+		{
+			return VectorMultiplyAdd(VectorLoadAligned(Corners[Corner][2]), CZ,
+				VectorAdd(VectorMultiply(VectorLoadAligned(Corners[Corner][0]), CX), VectorMultiply(VectorLoadAligned(Corners[Corner][1]), CY)));
+		};
+
+		const VectorRegister4Float U = FadeVector(X);
+		const VectorRegister4Float V = FadeVector(Y);
+		const VectorRegister4Float W = FadeVector(Z);
+
+		const VectorRegister4Float Near = LerpVector(
+			LerpVector(CornerGrad(0, X, Y, Z), CornerGrad(1, X1, Y, Z), U),
+			LerpVector(CornerGrad(2, X, Y1, Z), CornerGrad(3, X1, Y1, Z), U), V);
+		const VectorRegister4Float Far = LerpVector(
+			LerpVector(CornerGrad(4, X, Y, Z1), CornerGrad(5, X1, Y, Z1), U),
+			LerpVector(CornerGrad(6, X, Y1, Z1), CornerGrad(7, X1, Y1, Z1), U), V);
+
+		VectorStore(LerpVector(Near, Far, W), Out);
+	}
+#endif
+
+	/** Inoise of Num points, widest kernel first */
+	static void InoiseBatch(const float* X, const float* Y, const float* Z, float* Out, int32 Num)
+	{
+		const FTables& Tables = GetTables();
+
+		int32 Index = 0;
+#if GEOCLIPMAP_NOISE_AVX2
+		for (; Index + 8 <= Num; Index += 8)
+		{
+			InoiseAVX2(Tables, X + Index, Y + Index, Z + Index, Out + Index);
+		}
+#endif
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			InoiseVector(Tables, X + Index, Y + Index, Z + Index, Out + Index);
+		}
+#endif
+		for (; Index < Num; Index++)
+		{
+			Out[Index] = Inoise(Tables, X[Index], Y[Index], Z[Index]);
+		}
+	}
+
+	/** Positions of up to BatchSize points, divided by PosScaling */
+	struct FPositions
+	{
+		float X[BatchSize];
+		float Y[BatchSize];
+		float Z[BatchSize];
+	};
+
+	/** fBm(), turbulence() or ridgedmf() of the material functions, without the offset */
+	static void Fractal(const FGeoClipmapNoiseLayer& Layer, const FPositions& Positions, int32 Num, float* Out)
+	{
+		FPositions Scaled;
+		float Noise[BatchSize];
+		float Previous[BatchSize];
+
+		const bool bTurbulence = Layer.Type == EGeoClipmapNoiseType::Turbulence;
+		const bool bRidged = Layer.Type == EGeoClipmapNoiseType::Ridged;
+		const int32 Octaves = (int32)Layer.Octave;
+
+		float Frequency = 1.f;
+		float Amplitude = bTurbulence ? 1.f : 0.5f;
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Out[Index] = 0.f;
+			Previous[Index] = 1.f;
+		}
+
+		for (int32 OctaveIdx = 0; OctaveIdx < Octaves; OctaveIdx++)
+		{
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Scaled.X[Index] = Positions.X[Index] * Frequency;
+				Scaled.Y[Index] = Positions.Y[Index] * Frequency;
+				Scaled.Z[Index] = Positions.Z[Index] * Frequency;
+			}
+
+			InoiseBatch(Scaled.X, Scaled.Y, Scaled.Z, Noise, Num);
+
+			if (bRidged)
+			{
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					float Ridge = Layer.Offset - FMath::Abs(Noise[Index]);
+					Ridge *= Ridge;
+					Out[Index] += Ridge * Amplitude * Previous[Index];
+					Previous[Index] = Ridge;
+				}
+			}
+			else if (bTurbulence)
+			{
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					Out[Index] += FMath::Abs(Noise[Index]) * Amplitude;
+				}
+			}
+			else
+			{
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					Out[Index] += Noise[Index] * Amplitude;
+				}
+			}
+
+			Frequency *= Layer.Lacunarity;
+			Amplitude *= Layer.Gain;
+		}
+	}
+
+	/** Warped becomes Positions + fBm(Warped), the UV + fBm(UV) of the warped material functions */
+	static void Warp(const FGeoClipmapNoiseLayer& Layer, const FPositions& Positions, FPositions& Warped, int32 Num)
+	{
+		float Noise[BatchSize];
+		Fractal(Layer, Warped, Num, Noise);
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Warped.X[Index] = Positions.X[Index] + Noise[Index];
+			Warped.Y[Index] = Positions.Y[Index] + Noise[Index];
+			Warped.Z[Index] = Positions.Z[Index] + Noise[Index];
+		}
+	}
+
+	static void EvaluatePositions(const FGeoClipmapNoiseLayer& Layer, const FPositions& Positions, int32 Num, float* Out)
+	{
+		switch (Layer.Type)
+		{
+		case EGeoClipmapNoiseType::Perlin:
+			InoiseBatch(Positions.X, Positions.Y, Positions.Z, Out, Num);
+			break;
+		case EGeoClipmapNoiseType::FBM_1TimeWarped:
+		case EGeoClipmapNoiseType::FBM_2TimesWarped:
+		{
+			FPositions Warped = Positions;
+			Warp(Layer, Positions, Warped, Num);
+			if (Layer.Type == EGeoClipmapNoiseType::FBM_2TimesWarped)
+			{
+				Warp(Layer, Positions, Warped, Num);
+			}
+			Fractal(Layer, Warped, Num, Out);
+			break;
+		}
+		default:
+			Fractal(Layer, Positions, Num, Out);
+			break;
+		}
+
+		if (Layer.Type != EGeoClipmapNoiseType::Ridged && Layer.Type != EGeoClipmapNoiseType::Turbulence)
+		{
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Out[Index] += Layer.Offset;
+			}
+		}
+	}
+}
+
+float FGeoClipmapNoise::ImprovedPerlin(const FVector3f& Position)
+{
+	return GeoClipmapNoise::Inoise(GeoClipmapNoise::GetTables(), Position.X, Position.Y, Position.Z);
+}
+
+float FGeoClipmapNoise::Evaluate(const FGeoClipmapNoiseLayer& Layer, const FVector& WorldPosition)
+{
+	float Value = 0.f;
+	const double X = WorldPosition.X;
+	const double Y = WorldPosition.Y;
+	EvaluateBatch(Layer, MakeArrayView(&X, 1), MakeArrayView(&Y, 1), WorldPosition.Z, MakeArrayView(&Value, 1));
+	return Value;
+}
+
+void FGeoClipmapNoise::EvaluateBatch(const FGeoClipmapNoiseLayer& Layer, TArrayView<const double> X, TArrayView<const double> Y, double Z, TArrayView<float> OutValues)
+{
+	check(Y.Num() == X.Num() && OutValues.Num() == X.Num());
+
+	if (Layer.PosScaling == 0.f)
+	{
+		for (float& Value : OutValues)
+		{
+			Value = 0.f;
+		}
+		return;
+	}
+
+	// Scaled in double, world positions far from the origin keep their precision once divided
+	const float ScaledZ = (float)(Z / Layer.PosScaling);
+
+	GeoClipmapNoise::FPositions Positions;
+	for (int32 First = 0; First < X.Num(); First += GeoClipmapNoise::BatchSize)
+	{
+		const int32 Num = FMath::Min(GeoClipmapNoise::BatchSize, X.Num() - First);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Positions.X[Index] = (float)(X[First + Index] / Layer.PosScaling);
+			Positions.Y[Index] = (float)(Y[First + Index] / Layer.PosScaling);
+			Positions.Z[Index] = ScaledZ;
+		}
+
+		GeoClipmapNoise::EvaluatePositions(Layer, Positions, Num, OutValues.GetData() + First);
+	}
+}
+
+void FGeoClipmapNoise::EvaluateUVBatch(const FGeoClipmapNoiseLayer& Layer, TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutValues)
+{
+	check(Y.Num() == X.Num() && Z.Num() == X.Num() && OutValues.Num() == X.Num());
+
+	GeoClipmapNoise::FPositions Positions;
+	for (int32 First = 0; First < X.Num(); First += GeoClipmapNoise::BatchSize)
+	{
+		const int32 Num = FMath::Min(GeoClipmapNoise::BatchSize, X.Num() - First);
+		FMemory::Memcpy(Positions.X, X.GetData() + First, Num * sizeof(float));
+		FMemory::Memcpy(Positions.Y, Y.GetData() + First, Num * sizeof(float));
+		FMemory::Memcpy(Positions.Z, Z.GetData() + First, Num * sizeof(float));
+
+		GeoClipmapNoise::EvaluatePositions(Layer, Positions, Num, OutValues.GetData() + First);
+	}
+}
@@ -0,0 +1,104 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Noise/GeoClipmapNoise.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GeoClipmapNoiseTest
+{
+	/** A batch of 15 goes through the AVX2 kernel for 8 points when the module is compiled for it, the VectorRegister one for 4 and the scalar one for the last 3 */
+	static constexpr int32 NumPoints = 15;
+
+	/**
+	*	References are shader side: the HLSL of the ImprovedPerlin library Custom node evaluated step by step in float32,
+	*	sampling the texels of T_permuTexture2d and T_permGradTexture as the material does (point filtered, RGB read as linear).
+	*	The kernels stayed within 1e-6 of them. The tolerance leaves room for GPU and compilers fusing multiply adds.
+	*/
+	static constexpr float Tolerance = 1e-4f;
+
+	static const float InoiseReference[NumPoints] =
+	{
+		-0.137576f, -0.219102f, -0.018134f, -0.122386f, -0.335038f, 0.080260f, 0.094758f, -0.098401f, 0.157497f, 0.080766f, -0.241508f, 0.341634f, 0.233056f, -0.170098f, -0.008709f,
+	};
+
+	/** Indexed by EGeoClipmapNoiseType, default FGeoClipmapNoiseLayer settings */
+	static const float LayerReference[6][NumPoints] =
+	{
+		{ 0.573663f, 0.574426f, 0.835138f, 0.482870f, 0.273636f, 0.833914f, 1.473572f, 0.923321f, 0.503325f, 1.002864f, 0.804984f, 0.685066f, 0.400217f, 0.890032f, 0.483246f },
+		{ 0.689926f, 0.721326f, 0.679612f, 0.573961f, 0.572909f, 0.832393f, 1.145695f, 0.816444f, 0.594091f, 0.898403f, 0.744630f, 0.577712f, 0.567047f, 0.628683f, 0.740157f },
+		{ 0.680843f, 0.732205f, 0.681078f, 0.589072f, 0.504939f, 0.569564f, 0.680459f, 0.619429f, 0.574044f, 0.863536f, 0.750649f, 0.794994f, 0.498035f, 0.644555f, 0.755846f },
+		{ 0.642541f, 0.708274f, 0.677016f, 0.574745f, 0.767774f, 0.641086f, 1.142129f, 0.727724f, 0.616400f, 0.871270f, 0.688609f, 0.680396f, 0.502194f, 0.663272f, 0.778311f },
+		{ 0.197901f, 0.193403f, 0.189577f, 0.171189f, 0.062400f, 0.189041f, 0.023836f, 0.149452f, 0.197913f, 0.105727f, 0.226670f, 0.269263f, 0.125688f, 0.142227f, 0.123018f },
+		{ 0.366487f, 0.359631f, 0.362667f, 0.306710f, 0.636058f, 0.383924f, 0.917481f, 0.374303f, 0.237439f, 0.499780f, 0.262070f, 0.260260f, 0.392292f, 0.529435f, 0.596373f },
+	};
+
+	/** Every gradient of inoise() is dotted with a zero offset on lattice points, whatever the textures hold */
+	static const FVector3f LatticePoints[] =
+	{
+		FVector3f(0.f, 0.f, 0.f), FVector3f(1.f, 2.f, 3.f), FVector3f(-17.f, 255.f, 4.f), FVector3f(256.f, -1.f, -300.f),
+	};
+
+	static const double Z = 1234.0;
+
+	static FVector GetWorldPosition(int32 Index)
+	{
+		return FVector(-350000.0 + Index * 51234.5, 123456.0 - Index * 37771.25, Z);
+	}
+
+	static FVector3f GetNoisePosition(int32 Index)
+	{
+		return FVector3f((float)(Index * 1.37 - 7.1), (float)(Index * -0.73 + 3.3), (float)(Index * 0.11 + 0.5));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGeoClipmapNoiseParityTest, "ProceduralLandscape.Noise.Parity", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGeoClipmapNoiseParityTest::RunTest(const FString& Parameters)
+{
+	using namespace GeoClipmapNoiseTest;
+
+	for (int32 Index = 0; Index < NumPoints; Index++)
+	{
+		TestEqual(FString::Printf(TEXT("Inoise %d"), Index), FGeoClipmapNoise::ImprovedPerlin(GetNoisePosition(Index)), InoiseReference[Index], Tolerance);
+	}
+
+	for (const FVector3f& Point : LatticePoints)
+	{
+		TestEqual(FString::Printf(TEXT("Inoise lattice %s"), *Point.ToString()), FGeoClipmapNoise::ImprovedPerlin(Point), 0.f, Tolerance);
+	}
+
+	TArray<double> X;
+	TArray<double> Y;
+	for (int32 Index = 0; Index < NumPoints; Index++)
+	{
+		const FVector Position = GetWorldPosition(Index);
+		X.Add(Position.X);
+		Y.Add(Position.Y);
+	}
+
+	const UEnum* NoiseTypes = StaticEnum<EGeoClipmapNoiseType>();
+
+	for (int32 TypeIdx = 0; TypeIdx < UE_ARRAY_COUNT(LayerReference); TypeIdx++)
+	{
+		FGeoClipmapNoiseLayer Layer;
+		Layer.Type = (EGeoClipmapNoiseType)TypeIdx;
+		const FString TypeName = NoiseTypes->GetNameStringByIndex(TypeIdx);
+
+		TArray<float> Batch;
+		Batch.SetNumZeroed(NumPoints);
+		FGeoClipmapNoise::EvaluateBatch(Layer, X, Y, Z, Batch);
+
+		for (int32 Index = 0; Index < NumPoints; Index++)
+		{
+			// A single point only goes through the scalar kernel
+			TestEqual(FString::Printf(TEXT("%s scalar %d"), *TypeName, Index), FGeoClipmapNoise::Evaluate(Layer, GetWorldPosition(Index)), LayerReference[TypeIdx][Index], Tolerance);
+			TestEqual(FString::Printf(TEXT("%s batch %d"), *TypeName, Index), Batch[Index], LayerReference[TypeIdx][Index], Tolerance);
+		}
+	}
+
+	return true;
+}
+
+#endif
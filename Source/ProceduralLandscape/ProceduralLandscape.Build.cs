@@ -35,7 +35,8 @@ public class ProceduralLandscape : ModuleRules
 	            "InteractiveToolsFramework",
 	            "MeshDescription",            
 	            "StaticMeshDescription",
-				"PhysicsCore"
+				"PhysicsCore",
+				"ProceduralLandscapeShaders"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -48,6 +49,7 @@ public class ProceduralLandscape : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Chaos",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -4,8 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Async/Future.h"
+#include "RenderCommandFence.h"
+#include "RHIGPUReadback.h"
+#include "Component/GeoClipmapHeightPyramid.h"
+#include "Component/GeoClipmapHeightfieldComponent.h"
+#include "Noise/GeoClipmapHeightProgram.h"
 #include "GeometryClipMapWorld.generated.h"
 
+class FGeoClipmapRingGeometry;
+
 class UProceduralMeshComponent;
 class UMaterialInterface;
 class UMaterialInstanceDynamic;
@@ -16,6 +24,7 @@ class UGeoClipmapMeshComponent;
 class UInstancedStaticMeshComponent;
 class UMaterialParameterCollection;
 class UTextureRenderTarget2DArray;
+class UMaterialFunctionInterface;
 
 UENUM(BlueprintType)
 enum class EGeoClipWorldType : uint8
@@ -29,6 +38,8 @@ enum class EWorldPresentation : uint8
 {
 	Smooth UMETA(DisplayName = "Triangle Based Terrain"),
 	InstancedMesh UMETA(DisplayName = "InstancedMesh Shaped"),
+	/*Triangle based, the rings have no vertex buffer and rebuild their vertices from the vertex id*/
+	Bufferless UMETA(DisplayName = "Bufferless Triangle Based Terrain"),
 };
 
 UENUM(BlueprintType)
@@ -52,13 +63,37 @@ enum class ENValue : uint8
 	N15 UMETA(DisplayName = "15"),
 };
 
+/** Cached HeightMap of a level being read back from the GPU, reused by every read of the level */
+struct FClipMapHeightRead
+{
+	/** Only touched by the render thread */
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+	TArray<FColor> Texels;
+	int32 Resolution = 0;
+	/** Location of the level when HeightMap was drawn */
+	FVector Location = FVector::ZeroVector;
+	/** Game thread side, waiting on Readback */
+	bool bInFlight = false;
+	/** Read issued by the game thread, the render thread's copy of it, and the read Texels holds */
+	int32 Serial = 0;
+	int32 EnqueuedSerial = 0;
+	FThreadSafeCounter CopiedSerial;
+};
+
 USTRUCT()
 struct FClipMapMeshElement
 {
 	GENERATED_BODY()
 
+	/** Component drawing every level, shared by all the elements */
 	UPROPERTY(Transient)
 		UGeoClipmapMeshComponent* Mesh = nullptr;
+	/** Level of Mesh drawing this element */
+	UPROPERTY(Transient)
+		int MeshLevel = INDEX_NONE;
+	/** Section of Mesh the ring sections of this element start at */
+	UPROPERTY(Transient)
+		int FirstSection = 0;
 
 	//In case we're using instancedMesh for rendering
 	UPROPERTY(Transient)
@@ -101,6 +136,14 @@ struct FClipMapMeshElement
 	UPROPERTY(Transient)
 	TArray<bool> SectionVisibility;
 
+	/** Min and max heights of HeightMap, bounding the sections of this level */
+	FGeoClipmapHeightPyramid HeightPyramid;
+	FVector HeightPyramidLocation = FVector::ZeroVector;
+	/** Read back of HeightMap, a read issued when the level moves supersedes the one in flight */
+	TSharedPtr<FClipMapHeightRead, ESPMode::ThreadSafe> HeightRead;
+	/** HeightMap had no resource when the read was requested, ProcessHeightBoundsPending requests it again */
+	bool bHeightReadPending = false;
+
 	bool IsSectionVisible(int SectionID);
 	void SetSectionVisible(int SectionID,bool NewVisibility);
 };
@@ -117,22 +160,49 @@ struct FClipMapLayer
 	UPROPERTY(Transient)
 		int ID=0;
 };
+/** Slot of the ring of collision tiles being read back from the GPU */
+struct FCollisionHeightRead
+{
+	/** Only touched by the render thread, reused by every read of the slot */
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+	TArray<FColor> Texels;
+	int32 Resolution = 0;
+	/** Collision mesh read, and its location when CollisionRT was drawn */
+	int32 MeshID = INDEX_NONE;
+	FVector Location = FVector::ZeroVector;
+	/** Game thread side, the slot is waiting on Readback */
+	bool bInFlight = false;
+	/** Read issued by the game thread, the render thread's copy of it, and the read Texels holds */
+	int32 Serial = 0;
+	int32 EnqueuedSerial = 0;
+	FThreadSafeCounter CopiedSerial;
+};
+
 USTRUCT()
 struct FCollisionMeshElement
 {
 	GENERATED_BODY()
 
+	/** Procedural mesh tile, when HeightfieldCollision is off */
 	UPROPERTY(Transient)
 		UProceduralMeshComponent* Mesh = nullptr;
+	/** Heightfield tile, when HeightfieldCollision is on */
+	UPROPERTY(Transient)
+		UGeoClipmapHeightfieldComponent* Heightfield = nullptr;
 	UPROPERTY(Transient)
 		UTextureRenderTarget2D* CollisionRT = nullptr;
 	UPROPERTY(Transient)
 		FVector Location;
 	UPROPERTY(Transient)
 		int ID;
+	/** Collision LOD the tile was built for, its world dimension is CollisionMeshWorldDimension * 2^LOD */
+	UPROPERTY(Transient)
+		int LOD = 0;
 	UPROPERTY(Transient)
 	TArray<FColor> HeightData;
 
+	/** Component of the tile, whichever backend it uses */
+	USceneComponent* GetComponent() const;
 };
 
 USTRUCT()
@@ -301,6 +371,7 @@ public:
 
 	bool ShouldTickIfViewportsOnly() const override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
 
 #endif
 
@@ -327,6 +398,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings",meta = (EditCondition = "EnableCaching"))
 		int LOD_above_doubleCacheResolution = 2;
 
+	/*Bound the rings with the heights read back from the cached HeightMaps instead of the vertical jitter. VerticalRangeMeters then only bounds the rings until the first read back*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings",meta = (EditCondition = "EnableCaching"))
+		bool CacheHeightBounds = true;
+	/*CacheMat writes the height as an int32 packed in the RGBA8 HeightMap, R holding the highest byte, as the Heightmap and Reference demo cache materials do. When off, or when the HeightMap is not RGBA8, the rings stay bounded with VerticalRangeMeters*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings",meta = (EditCondition = "EnableCaching && CacheHeightBounds"))
+		bool CacheMatPacksHeight = true;
+
 	UPROPERTY(Transient,EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings")
 		bool rebuild=false;
 	UPROPERTY(Transient, EditAnywhere, BlueprintReadWrite, Category = "Spawnables")
@@ -347,13 +425,18 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings")
 		int Level = 8;
+
+	/*Store the rings as 8 bytes grid coordinates instead of full vertices, UVs are rebuilt by the vertex factory. Materials are unchanged*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings")
+		bool CompactVertices = false;
 	/*Hack the culling of the landscape with vertical noise*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Hack Culling")
 		float VerticalRangeMeters = 0.f;
 
 	UPROPERTY(/*EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings"*/)
 		EGeoClipWorldType WorldType = EGeoClipWorldType::FlatWorld;
-	UPROPERTY(/*EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings"*/)
+	/*Bufferless drops the ring vertex buffers, CompactVertices is then ignored*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings")
 		EWorldPresentation WorldPresentation = EWorldPresentation::Smooth;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ClipMap Settings")
@@ -375,10 +458,29 @@ public:
 		int CollisionMeshVerticeNumber = 65;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
 		float CollisionMeshWorldDimension = 6400.f;
+	/*Concentric rings of collision tiles, each one made of tiles twice as large as the previous with as many vertices. 1 keeps a single ring of full resolution tiles*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
+		int CollisionLODs = 1;
+	/*Collision tiles are Chaos heightfields built straight from the heights, instead of procedural meshes cooked on every update. Only procedural mesh tiles draw CollisionMat.
+	Heights are stored on 16 bits between the lowest and highest vertex of each tile, a step of at most 2 * VerticalRangeMeters * 100 / 65535 cm when the heights stay within VerticalRangeMeters:
+	about 3 cm for 1000 m. Vertices are within half a step of the procedural mesh ones, a warning is logged otherwise*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
+		bool HeightfieldCollision = false;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
 		UMaterialInterface* CollisionMat;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
 		UMaterialInterface* CollisionMat_HeightRead;
+	/*Collision tiles read back from CollisionMat_HeightRead at once, each read completes a few frames later without stalling the game thread. Tiles past it wait for a free read*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
+		int CollisionReadbacksInFlight = 8;
+	/*Noise of the landscape material, evaluated on the CPU by ComputeWorldHeightAt. When set, collisions are computed from it instead of reading back CollisionMat_HeightRead*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision Settings")
+		TArray<FGeoClipmapNoiseLayer> CPUHeightLayers;
+#if WITH_EDITORONLY_DATA
+	/*Material function defining the landscape height, translated on edit and on save to be evaluated on the CPU. Takes over CPUHeightLayers once translated*/
+	UPROPERTY(EditAnywhere, Category = "Collision Settings")
+		UMaterialFunctionInterface* CPUHeightFunction = nullptr;
+#endif
 
 	UPROPERTY(Transient)
 		float TimeAcuSpawnable = 0.0f;
@@ -406,6 +508,10 @@ protected:
 	UPROPERTY(Transient)
 		TArray<FClipMapMeshElement> Meshes;
 
+	/** Single component, and scene proxy, drawing every level of the mesh presentations */
+	UPROPERTY(Transient)
+		UGeoClipmapMeshComponent* ClipMapMesh = nullptr;
+
 	UPROPERTY(Transient)
 		TArray<FMeshElementOffset> MeshesOffset;
 
@@ -418,17 +524,24 @@ protected:
 
 	UPROPERTY(Transient)
 		TArray<int> CollisionReadToProcess;
+	/** Collision meshes waiting for a free slot of CollisionReadbacks */
+	UPROPERTY(Transient)
+		TArray<int> CollisionReadQueued;
+	/** Ring of GPU reads of the collision meshes, at most CollisionReadbacksInFlight */
+	TArray<TSharedPtr<FCollisionHeightRead, ESPMode::ThreadSafe>> CollisionReadbacks;
 
+	/** Collision tiles by X and Y in tiles of their LOD, and LOD in Z */
 	UPROPERTY(Transient)
 		TMap<FIntVector,FCollisionMeshElement> GroundCollisionLayout;
 
-	FCollisionMeshElement& GetACollisionMesh();
+	/** Available collision mesh built for LOD, or a new one */
+	FCollisionMeshElement& GetACollisionMesh(int LOD);
+	float GetCollisionTileDimension(int LOD) const { return CollisionMeshWorldDimension * (1 << LOD); }
 	void ReleaseCollisionMesh(int ID);
 
 	void Setup();
 	void InitiateWorld();
 	void SetN();
-	void CreateGridMeshWelded(int LOD, int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs,TArray<FVector2D>& UV1s,TArray<FVector2D>& UV2s, float& GridSpacing, FVector& Offset, uint8 StitchProfil);
 	void UpdateCameraLocation();
 	float HeightToClosestCollisionMesh();
 	void UpdateClipMap();
@@ -437,8 +550,25 @@ protected:
 	bool CanUpdateSpawnables();
 
 	double GetHeightFromGPURead(FColor& ReadLoc);
+	/** Draw CollisionMat_HeightRead for Mesh and read it back in a free slot of CollisionReadbacks, false when none is free or CollisionRT has no resource yet */
+	bool RequestCollisionRead(FCollisionMeshElement& Mesh);
+	/** Hand the completed reads to ProcessCollisionsPending, then issue the queued ones */
+	void PollCollisionReads();
 	void ProcessCollisionsPending();
+
+	/** Read back the HeightMap of a level, its sections are bounded once it completes. False while HeightMap has no resource, the read is then retried */
+	bool RequestHeightBounds(FClipMapMeshElement& Elem);
+	void ProcessHeightBoundsPending();
+	/** HeightMap holds heights GetHeightFromGPURead can decode, see CacheMatPacksHeight */
+	bool CanReadHeightBounds(const UTextureRenderTarget2D* HeightMap);
+	/** Bound the sections and blocks of a level with its HeightPyramid, or with VerticalRangeMeters while it is not read back */
+	void UpdateLevelHeightBounds(FClipMapMeshElement& Elem);
+	/** CPUHeightFunction or CPUHeightLayers was set up, heights can be computed without the GPU */
+	bool HasCPUHeight() const { return CPUHeightProgram.IsValid() || CPUHeightLayers.Num() > 0; }
+	/** Actor height plus CPUHeightProgram, or CPUHeightLayers, sampled on the actor plane */
 	double ComputeWorldHeightAt(FVector WorldLocation);
+	/** ComputeWorldHeightAt of X.Num() locations in a single batch */
+	void ComputeWorldHeightsAt(TArrayView<const double> X, TArrayView<const double> Y, TArrayView<double> OutHeights);
 	void UpdateCollisionMeshData(FCollisionMeshElement& Mesh );
 
 	FTransform GetWorldTransformOfSpawnable(const FVector& CompLoc, FColor& LocX, FColor& LocY, FColor& LocZ, FColor& Rot);
@@ -454,8 +584,26 @@ protected:
 	FRenderCommandFence RTUpdate;
 
 	bool GenerateCollision_last = false;
+	bool HeightfieldCollision_last = false;
 	float VerticalRangeMeters_last = 0.f;
 	bool Caching_last=false;
+	bool CompactVertices_last = false;
+	bool CacheHeightBounds_last = true;
+	bool CacheMatPacksHeight_last = true;
+	bool HeightMapFormatWarned = false;
+	EWorldPresentation WorldPresentation_last = EWorldPresentation::Smooth;
+
+	/** CPUHeightFunction translated in editor, saved so cooked builds evaluate it without the material graph */
+	UPROPERTY()
+		FGeoClipmapHeightProgram CPUHeightProgram;
+#if WITH_EDITOR
+	void TranslateCPUHeightFunction();
+#endif
+
+	/** Unit scaled ring shared by every level, each level scales it by its GridSpacing */
+	TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> RingGeometry;
+	/** Ring geometry being built on worker threads, see InitiateWorld */
+	TFuture<TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe>> PendingRingGeometry;
 
 	int DrawCall_Spawnables_count = 0;
 	UStaticMesh* Spawnable_Stopped = nullptr; 
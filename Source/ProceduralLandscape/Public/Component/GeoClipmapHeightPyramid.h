@@ -0,0 +1,40 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+*	Min and max heights of a square height map, and of every power of two block of its texels.
+*	Bounds any texel rectangle by reading a handful of cells instead of every texel.
+*/
+class PROCEDURALLANDSCAPE_API FGeoClipmapHeightPyramid
+{
+public:
+	/** Build the pyramid from Resolution x Resolution heights, in row major order */
+	void Build(TArrayView<const float> Heights, int32 Resolution);
+
+	void Reset() { Mips.Reset(); }
+
+	bool IsValid() const { return Mips.Num() > 0; }
+
+	/** Size of the height map the pyramid was built from */
+	int32 GetResolution() const { return Mips.Num() > 0 ? Mips[0].Size : 0; }
+
+	/**
+	*	Conservative min and max heights of the texels in [MinTexel, MaxTexel], inclusive and clamped to the height map.
+	*	@return false when the pyramid is empty
+	*/
+	bool GetHeightRange(const FIntPoint& MinTexel, const FIntPoint& MaxTexel, float& OutMinHeight, float& OutMaxHeight) const;
+
+private:
+	struct FMip
+	{
+		int32 Size = 0;
+		/** Min height in X, max height in Y */
+		TArray<FVector2f> MinMax;
+	};
+
+	/** Mip 0 is the height map itself, each next one halves the size until a single cell */
+	TArray<FMip> Mips;
+};
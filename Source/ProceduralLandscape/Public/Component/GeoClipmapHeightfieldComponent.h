@@ -0,0 +1,58 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "GeoClipmapHeightfieldComponent.generated.h"
+
+/**
+*	Collision tile backed by a Chaos heightfield, built straight from a regular grid of heights.
+*	Skips the triangle mesh cooking and BVH build of a procedural mesh, and stores each height on 16 bits.
+*	Does not render.
+*/
+UCLASS(hidecategories = (Object, LOD, Rendering), ClassGroup = Collision)
+class PROCEDURALLANDSCAPE_API UGeoClipmapHeightfieldComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+public:
+
+	UGeoClipmapHeightfieldComponent(const FObjectInitializer& ObjectInitializer);
+
+	/** Grid of NumVertices x NumVertices heights, Spacing apart along X and Y from the component origin. Clears the heights */
+	void SetGrid(int32 InNumVertices, float InSpacing);
+
+	/**
+	*	Replace the heightfield.
+	*	@param InHeights	Heights relative to the component of the grid vertices, row major along X
+	*/
+	void SetHeights(TArray<float>&& InHeights);
+
+	int32 GetNumVertices() const { return NumVertices; }
+	float GetSpacing() const { return Spacing; }
+
+	/** Grid and heights range, relative to the component */
+	FBox GetLocalBox() const;
+
+	/** Height difference between two consecutive 16 bit values, the heights range of the tile split in 65535 steps */
+	float GetQuantizationStep() const;
+	/** Largest difference between a vertex of the physics heightfield and its height, once the physics state is created */
+	float GetMaxHeightError() const { return MaxHeightError; }
+
+	//~ Begin UPrimitiveComponent Interface.
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	virtual bool ShouldCreatePhysicsState() const override;
+protected:
+	virtual void OnCreatePhysicsState() override;
+	virtual void OnDestroyPhysicsState() override;
+	//~ End UPrimitiveComponent Interface.
+
+private:
+	int32 NumVertices = 0;
+	float Spacing = 1.f;
+
+	TArray<float> Heights;
+	float MinHeight = 0.f;
+	float MaxHeight = 0.f;
+	float MaxHeightError = 0.f;
+};
@@ -7,13 +7,20 @@
 #include "Interfaces/Interface_CollisionDataProvider.h"
 #include "Components/MeshComponent.h"
 #include "PhysicsEngine/ConvexElem.h"
+#include "GeoClipmapVertexTypes.h"
 #include "GeoClipmapMeshComponent.generated.h"
 
 
 
 class FPrimitiveSceneProxy;
+class FGeoClipmapSharedSection;
+class FGeoClipmapSectionRenderCache;
+
+typedef TSharedPtr<const FGeoClipmapSharedSection, ESPMode::ThreadSafe> FGeoClipmapSharedSectionPtr;
+typedef TSharedPtr<FGeoClipmapSectionRenderCache, ESPMode::ThreadSafe> FGeoClipmapSectionRenderCachePtr;
 
 DECLARE_STATS_GROUP(TEXT("GeoClipProceduralMesh"), STATGROUP_GeoClipProceduralMesh, STATCAT_Advanced);
+DECLARE_LOG_CATEGORY_EXTERN(LogGeoClipProceduralComponent, Log, All);
 
 /**
 *	Struct used to specify a tangent vector for a vertex
@@ -101,6 +108,31 @@ public:
 	{}
 };
 
+/** Part of a shared section a component section draws */
+struct FGeoClipmapIndexRange
+{
+	int32 FirstIndex = 0;
+	/** INDEX_NONE for every index of the shared section */
+	int32 NumIndices = INDEX_NONE;
+	/** Added to every index of the range when drawn, Min and MaxVertexIndex are relative to it */
+	int32 BaseVertexIndex = 0;
+	int32 MinVertexIndex = 0;
+	int32 MaxVertexIndex = 0;
+	/** Bounds of the vertices the range references */
+	FBox LocalBox = FBox(ForceInit);
+};
+
+/** Placement of one level of a multi-level component, relative to the component */
+struct FGeoClipmapLevel
+{
+	FVector Offset = FVector::ZeroVector;
+	FVector Scale = FVector::OneVector;
+	/** Union of the local boxes of the sections drawn by this level, before Offset and Scale */
+	FBox SectionsBox = FBox(ForceInit);
+
+	FMatrix GetLevelToLocal() const { return FScaleMatrix(Scale) * FTranslationMatrix(Offset); }
+};
+
 /** One section of the procedural mesh. Each material has its own section. */
 USTRUCT()
 struct FGeoCProcMeshSection
@@ -112,9 +144,13 @@ public:
 	UPROPERTY()
 	TArray<FGeoCProcMeshVertex> ProcVertexBuffer;
 
-	/** Index buffer for this section */
+	/** Index buffer for this section, empty when ProcIndexBuffer16 is used */
 	UPROPERTY()
 	TArray<uint32> ProcIndexBuffer;
+
+	/** 16 bit index buffer, used instead of ProcIndexBuffer when the section has no more than 65536 vertices */
+	UPROPERTY()
+	TArray<uint16> ProcIndexBuffer16;
 	/** Local bounding box of section */
 	UPROPERTY()
 	FBox SectionLocalBox;
@@ -127,6 +163,42 @@ public:
 	UPROPERTY()
 	bool bSectionVisible;
 
+	/** Number of UV channels the section was created with, the others are not allocated on the GPU */
+	UPROPERTY()
+	uint8 NumTexCoords = 4;
+
+	/** False when the section was created without vertex colors, it then renders with the default white color */
+	UPROPERTY()
+	bool bHasVertexColors = true;
+
+	/** False when the section was created without normals nor tangents, it then renders with shared up facing tangents */
+	UPROPERTY()
+	bool bHasTangents = true;
+
+	/** Compact vertices, used instead of ProcVertexBuffer by sections built with compact vertices */
+	TArray<FGeoClipmapCompactVertex> CompactVertexBuffer;
+
+	/** Height of the vertical jitter of compact and bufferless vertices, in local units */
+	float CompactVerticalJitter = 0.f;
+
+	/** Grid patches of bufferless sections, which store no vertex at all */
+	TArray<FGeoClipmapGridPatch> GridPatches;
+
+	/** Geometry shared with other components, vertex and index buffers stay empty while it is set */
+	FGeoClipmapSharedSectionPtr SharedSection;
+
+	/** Indices of SharedSection this section draws */
+	FGeoClipmapIndexRange SharedRange;
+
+	/** Consecutive sub ranges of SharedRange with their own bounds, frustum culled one by one. Empty to draw SharedRange whole */
+	TArray<FGeoClipmapIndexRange> SharedBlocks;
+
+	/** GPU buffers of an owned section, reused by every scene proxy until the content of the section changes */
+	FGeoClipmapSectionRenderCachePtr RenderCache;
+
+	/** Level of the component drawing this section, INDEX_NONE to draw it with the component transform only */
+	int32 LevelIndex = INDEX_NONE;
+
 	FGeoCProcMeshSection()
 		: SectionLocalBox(ForceInit)
 		, bEnableCollision(false)
@@ -138,10 +210,48 @@ public:
 	{
 		ProcVertexBuffer.Empty();
 		ProcIndexBuffer.Empty();
+		ProcIndexBuffer16.Empty();
+		CompactVertexBuffer.Empty();
+		CompactVerticalJitter = 0.f;
+		GridPatches.Empty();
+		NumTexCoords = 4;
+		bHasVertexColors = true;
+		bHasTangents = true;
 		SectionLocalBox.Init();
 		bEnableCollision = false;
 		bSectionVisible = true;
+		SharedSection.Reset();
+		SharedRange = FGeoClipmapIndexRange();
+		SharedBlocks.Empty();
+		LevelIndex = INDEX_NONE;
+		RenderCache.Reset();
 	}
+
+	/** Vertices of this section, whether owned or shared. Empty for compact and bufferless sections */
+	const TArray<FGeoCProcMeshVertex>& GetVertexBuffer() const;
+	/** Number of vertices of this section, whether owned, shared, compact or bufferless */
+	int32 GetNumVertices() const;
+	/** True when the vertices are stored in CompactVertexBuffer */
+	bool UsesCompactVertices() const;
+	/** True when the vertices are rebuilt from GridPatches on the GPU */
+	bool UsesBufferlessVertices() const;
+	/** Number of indices of this section, whether owned or in its range of the shared section */
+	int32 GetNumIndices() const;
+	/** Vertex of this section, whether owned or in its range of the shared section, BaseVertexIndex included */
+	uint32 GetIndex(int32 Index) const;
+	/** Indices of the index buffer this section draws, the whole buffer unless it is a range of a shared section */
+	FGeoClipmapIndexRange GetIndexRange() const;
+	/** True when the indices are stored in ProcIndexBuffer16 */
+	bool Uses16BitIndices() const;
+
+	/** Copy Triangles into the index buffer, clamped below NumVerts, picking 16 bit indices when NumVerts allows it */
+	void SetIndices(const TArray<int32>& Triangles, int32 NumTriIndices, int32 NumVerts);
+
+	/** Number of vertices UpdateMeshSection takes for this section: the span of the shared vertices its range references, or its own full vertices */
+	int32 GetNumUpdatableVertices() const;
+
+	/** Copy the span of shared vertices this section references into it, so it can be modified */
+	void DetachSharedSection();
 };
 
 /**
@@ -232,8 +342,24 @@ public:
 		UpdateMeshSection_LinearColor(SectionIndex, Vertices, Normals, UV0, EmptyArray, EmptyArray, EmptyArray, VertexColors, Tangents);
 	}
 
+	/**
+	 *	Updates only the vertex positions of a section, for instance after a height displacement. Collision info is also updated.
+	 *	Tangents, UVs and colors are left untouched, only the position stream is uploaded.
+	 *	@param	Positions			New position of every vertex of the section, must have as many elements as the section has vertices.
+	 */
+	void UpdateMeshSectionPositions(int32 SectionIndex, TArrayView<const FVector3f> Positions);
+
 	void UpdateCustomBounds(FBoxSphereBounds Newbound);
 
+	/**
+	 *	Replace the bounds of a section and of its blocks, for instance once the heights of the terrain they cover are known.
+	 *	Boxes are in the space of the section level, BlockBoxes is ignored unless it has one box per block.
+	 */
+	void UpdateCustomBounds(int32 SectionIndex, const FBox& SectionBox, TArrayView<const FBox> BlockBoxes);
+
+	/** UpdateCustomBounds of the consecutive sections from FirstSectionIndex, the overall bounds are updated once for all of them */
+	void UpdateCustomBounds(int32 FirstSectionIndex, TArrayView<const FBox> SectionBoxes, TArrayView<const TArray<FBox>> BlockBoxes);
+
 	/** Clear a section of the procedural mesh. Other sections do not change index. */
 	UFUNCTION(BlueprintCallable, Category = "Components|ProceduralMesh")
 	void ClearMeshSection(int32 SectionIndex);
@@ -242,7 +368,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|ProceduralMesh")
 	void ClearAllMeshSections();
 
-	/** Control visibility of a particular section */
+	/** Control visibility of a particular section. Changes of a frame reach the scene proxy at once, as a single bitmask */
 	UFUNCTION(BlueprintCallable, Category = "Components|ProceduralMesh")
 	void SetMeshSectionVisible(int32 SectionIndex, bool bNewVisibility);
 
@@ -297,6 +423,29 @@ public:
 	/** Replace a section with new section geometry */
 	void SetProcMeshSection(int32 SectionIndex, const FGeoCProcMeshSection& Section);
 
+	/**
+	 *	Make a section reference geometry shared with other components instead of owning a copy.
+	 *	GPU buffers are shared as well, the section is detached into its own copy if later updated.
+	 *	Range selects the indices drawn, so several sections can be ranges of one shared section and its buffers.
+	 *	Blocks optionally split Range into consecutive sub ranges the scene proxy culls against each view.
+	 */
+	void SetSharedMeshSection(int32 SectionIndex, const FGeoClipmapSharedSectionPtr& SharedSection, const FGeoClipmapIndexRange& Range = FGeoClipmapIndexRange(), TArrayView<const FGeoClipmapIndexRange> Blocks = TArrayView<const FGeoClipmapIndexRange>());
+
+	/**
+	 *	Add a level, drawn by the same scene proxy as every other level of this component.
+	 *	Sections assigned to it are drawn with Scale then Offset applied on top of the component transform.
+	 *	@return Index of the new level
+	 */
+	int32 AddLevel(const FVector& Offset, const FVector& Scale);
+
+	/** Draw a section with the transform of a level, INDEX_NONE to draw it with the component transform only */
+	void SetSectionLevel(int32 SectionIndex, int32 LevelIndex);
+
+	/** Move a level without recreating the scene proxy nor updating the component transform. Bounds are only updated when the level leaves them */
+	void SetLevelTransform(int32 LevelIndex, const FVector& Offset, const FVector& Scale);
+
+	int32 GetNumLevels() const { return Levels.Num(); }
+
 	//~ Begin UPrimitiveComponent Interface.
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
 	virtual class UBodySetup* GetBodySetup() override;
@@ -311,6 +460,13 @@ public:
 	virtual void PostLoad() override;
 	//~ End UObject Interface.
 
+protected:
+	//~ Begin UActorComponent Interface.
+	virtual void SendRenderDynamicData_Concurrent() override;
+	//~ End UActorComponent Interface.
+
+public:
+
 
 
 
@@ -350,10 +506,14 @@ private:
 
 	/** Update LocalBounds member from the local box of each section */
 	void UpdateLocalBounds();
+	/** Update OcclusionLocalBounds from the current level transforms, without the slack of LocalBounds */
+	void UpdateOcclusionBounds();
 	/** Ensure ProcMeshBodySetup is allocated and configured */
 	void CreateProcMeshBodySetup();
 	/** Mark collision data as dirty, and re-create on instance if necessary */
 	void UpdateCollision();
+	/** Send the positions of every section with collision to the trimesh, after a vertex update */
+	void UpdateCollisionVertices();
 	/** Once async physics cook is done, create needed state */
 	void FinishPhysicsAsyncCook(bool bSuccess, UBodySetup* FinishedBodySetup);
 
@@ -368,6 +528,17 @@ private:
 	UPROPERTY()
 	TArray<FKConvexElem> CollisionConvexElems;
 
+	/** Levels the sections can be drawn with, see AddLevel */
+	TArray<FGeoClipmapLevel> Levels;
+
+	/** LocalBounds without the slack given to moving levels, used by occlusion queries */
+	FBoxSphereBounds OcclusionLocalBounds = FBoxSphereBounds(ForceInit);
+	/** Union of the local boxes of the sections drawn without a level */
+	FBox UnleveledSectionsBox = FBox(ForceInit);
+
+	/** Visibility of every section as the scene proxy knows it, changes are sent once per frame */
+	TBitArray<> ProxySectionVisibility;
+
 	/** Local space bounds of mesh */
 	UPROPERTY()
 	FBoxSphereBounds LocalBounds;
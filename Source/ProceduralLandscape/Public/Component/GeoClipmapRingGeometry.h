@@ -0,0 +1,147 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIDefinitions.h"
+#include "Component/GeoClipmapMeshComponent.h"
+
+class FGeoClipmapSectionRenderData;
+
+/** Sections every clipmap level is made of, see AGeometryClipMapWorld::UpdateClipMap for how they are toggled */
+namespace GeoClipmapRingSection
+{
+	enum Type : int32
+	{
+		FullRing = 0,
+		RingWithHole = 1,
+		InteriorBotLeft = 2,
+		InteriorTopLeft = 3,
+		InteriorBotRight = 4,
+		InteriorTopRight = 5,
+		Num = 6,
+	};
+}
+
+/** How the sections of a ring store their vertices */
+enum class EGeoClipmapVertexFormat : uint8
+{
+	/** FGeoCProcMeshVertex, rendered with FLocalVertexFactory */
+	Full,
+	/** FGeoClipmapCompactVertex, rendered with FGeoClipmapVertexFactory */
+	Compact,
+	/** No vertex at all, FGeoClipmapBufferlessVertexFactory rebuilds them from SV_VertexID and the section grid patches */
+	Bufferless,
+};
+
+/**
+*	Identifies a ring geometry.
+*	StitchProfile is the stitching applied on the outer border of the ring:
+*	1<<3 X=0 | 1<<2 X=N-1 | 1<<1 Y=0 | 1 Y=N-1
+*/
+struct FGeoClipmapRingGeometryKey
+{
+	int32 N = 255;
+	uint8 StitchProfile = 1 << 3 | 1 << 2 | 1 << 1 | 1;
+	/** Height of the alternating vertical offset used to hack the culling, in world units */
+	float VerticalJitter = 0.f;
+	EGeoClipmapVertexFormat VertexFormat = EGeoClipmapVertexFormat::Full;
+
+	FGeoClipmapRingGeometryKey() {}
+	FGeoClipmapRingGeometryKey(int32 InN, uint8 InStitchProfile, float InVerticalJitter, EGeoClipmapVertexFormat InVertexFormat = EGeoClipmapVertexFormat::Full)
+		: N(InN)
+		, StitchProfile(InStitchProfile)
+		, VerticalJitter(InVerticalJitter)
+		, VertexFormat(InVertexFormat)
+	{}
+
+	bool operator==(const FGeoClipmapRingGeometryKey& Other) const
+	{
+		return N == Other.N && StitchProfile == Other.StitchProfile && VerticalJitter == Other.VerticalJitter && VertexFormat == Other.VertexFormat;
+	}
+
+	bool operator!=(const FGeoClipmapRingGeometryKey& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FGeoClipmapRingGeometryKey& Key)
+	{
+		return HashCombine(HashCombine(HashCombine(::GetTypeHash(Key.N), ::GetTypeHash(Key.StitchProfile)), ::GetTypeHash(Key.VerticalJitter)), ::GetTypeHash((uint8)Key.VertexFormat));
+	}
+};
+
+/**
+*	Geometry referenced by any number of UGeoClipmapMeshComponent, each section of a ring being a range of it.
+*	GPU buffers are created by the first scene proxy using it and released with the last reference.
+*/
+class PROCEDURALLANDSCAPE_API FGeoClipmapSharedSection
+{
+public:
+	~FGeoClipmapSharedSection();
+
+	/** Unit scaled geometry, one unit being one GridSpacing */
+	FGeoCProcMeshSection Section;
+
+	/** Game thread, returns the buffers of this section, creating them on first use */
+	FGeoClipmapSectionRenderData* GetOrCreateRenderData(ERHIFeatureLevel::Type FeatureLevel) const;
+
+private:
+	mutable FCriticalSection RenderDataLock;
+	mutable FGeoClipmapSectionRenderData* RenderData = nullptr;
+};
+
+/**
+*	Unit scaled geometry of a whole clipmap ring, every section welded into a single mesh.
+*	Only GridSpacing differs between levels so each level references the same geometry and scales it through its transform.
+*	Geometries are cached by key and shared by every AGeometryClipMapWorld as long as one of them holds a reference.
+*/
+class PROCEDURALLANDSCAPE_API FGeoClipmapRingGeometry
+{
+public:
+	/** Thread safe, builds the geometry when it is not cached. Can be called from worker threads */
+	static TSharedRef<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> FindOrCreate(const FGeoClipmapRingGeometryKey& Key);
+
+	/** Thread safe, returns the cached geometry or null without building it */
+	static TSharedPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe> Find(const FGeoClipmapRingGeometryKey& Key);
+
+	const FGeoClipmapRingGeometryKey& GetKey() const { return Key; }
+
+	/** Welded geometry of every section, with one vertex buffer and one index buffer */
+	const FGeoClipmapSharedSectionPtr& GetMesh() const { return Mesh; }
+	/** Indices of GetMesh() one section is made of */
+	const FGeoClipmapIndexRange& GetSectionRange(int32 SectionIndex) const { return SectionRanges[SectionIndex]; }
+	/** Consecutive sub ranges of GetSectionRange(), one per non empty block of the section, each with its own bounds */
+	const TArray<FGeoClipmapIndexRange>& GetSectionBlocks(int32 SectionIndex) const { return SectionBlocks[SectionIndex]; }
+
+	/** Grid patches one section is made of, in the order their vertices are emitted */
+	static void GetSectionGridPatches(const FGeoClipmapRingGeometryKey& RingKey, int32 SectionIndex, TArray<FGeoClipmapGridPatch>& Patches);
+
+	/** Unit scaled geometry of one section, in grid order */
+	static void CreateSectionGeometry(const FGeoClipmapRingGeometryKey& RingKey, int32 SectionIndex, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UV, TArray<FVector2D>& UV1, TArray<FVector2D>& UV2);
+
+	/** Reorder Triangles for the post-transform vertex cache, returns false when the grid order was kept */
+	static bool OptimizeSectionTriangleOrder(TArray<int32>& Triangles, int32 NumVertices);
+
+	/** FIFO cache size the triangle orders are evaluated against */
+	static constexpr int32 ReferenceCacheSize = 32;
+
+	/** Sections are split along a NumBlocksPerSide x NumBlocksPerSide grid over the ring, so scene proxies can frustum cull the blocks */
+	static constexpr int32 NumBlocksPerSide = 4;
+
+	/** Append a NumX*NumY welded grid, with stitching on the borders flagged in StitchProfil. Indices come from the GeoClipmapGridIndices tables */
+	static void CreateGridMeshWelded(int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs, TArray<FVector2D>& UV1s, TArray<FVector2D>& UV2s, float GridSpacing, const FVector& Offset, uint8 StitchProfil, float VerticalJitter);
+
+private:
+	explicit FGeoClipmapRingGeometry(const FGeoClipmapRingGeometryKey& InKey);
+
+	void Build();
+
+	FGeoClipmapRingGeometryKey Key;
+	FGeoClipmapSharedSectionPtr Mesh;
+	FGeoClipmapIndexRange SectionRanges[GeoClipmapRingSection::Num];
+	TArray<FGeoClipmapIndexRange> SectionBlocks[GeoClipmapRingSection::Num];
+
+	static FCriticalSection CacheLock;
+	static TMap<FGeoClipmapRingGeometryKey, TWeakPtr<const FGeoClipmapRingGeometry, ESPMode::ThreadSafe>> Cache;
+};
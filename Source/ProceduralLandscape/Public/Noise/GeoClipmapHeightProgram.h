@@ -0,0 +1,97 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Noise/GeoClipmapNoise.h"
+#include "GeoClipmapHeightProgram.generated.h"
+
+/** Operations of a height program, each one mirrors a material expression */
+UENUM()
+enum class EGeoClipmapHeightOpType : uint8
+{
+	Constant,
+	WorldPosition,
+	Add,
+	Subtract,
+	Multiply,
+	Divide,
+	Min,
+	Max,
+	/*PositiveClampedPow, as the Power node*/
+	Power,
+	Abs,
+	OneMinus,
+	Floor,
+	Frac,
+	Saturate,
+	Sine,
+	Cosine,
+	/*Lerp from A to B by C*/
+	Lerp,
+	/*Clamp A between B and C*/
+	Clamp,
+	/*Components of A picked by Swizzle*/
+	Swizzle,
+	/*Components of A followed by the ones of B*/
+	Append,
+	/*Noise sampled at the UV in A*/
+	Noise,
+};
+
+/** Writes the register Result from up to three source registers */
+USTRUCT()
+struct FGeoClipmapHeightOp
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		EGeoClipmapHeightOpType Type = EGeoClipmapHeightOpType::Constant;
+	UPROPERTY()
+		int32 Result = INDEX_NONE;
+	UPROPERTY()
+		int32 A = INDEX_NONE;
+	UPROPERTY()
+		int32 B = INDEX_NONE;
+	UPROPERTY()
+		int32 C = INDEX_NONE;
+	/** Value of Constant */
+	UPROPERTY()
+		FLinearColor Value = FLinearColor::Transparent;
+	/** Source component of each Swizzle component, 2 bits each */
+	UPROPERTY()
+		int32 Swizzle = 0;
+	UPROPERTY()
+		FGeoClipmapNoiseLayer Noise;
+};
+
+/**
+*	Height material function translated to a list of operations over registers of up to 4 components.
+*	Evaluated per batch of points, each register component being an array over the batch.
+*/
+USTRUCT()
+struct PROCEDURALLANDSCAPE_API FGeoClipmapHeightProgram
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TArray<FGeoClipmapHeightOp> Ops;
+	/** Number of components of each register */
+	UPROPERTY()
+		TArray<int32> RegisterComponents;
+	/** Register holding the height, in its first component */
+	UPROPERTY()
+		int32 Output = INDEX_NONE;
+
+	bool IsValid() const { return Ops.Num() > 0 && RegisterComponents.IsValidIndex(Output); }
+
+	void Reset();
+
+	int32 AddRegister(int32 NumComponents);
+
+	/**
+	*	Height at X.Num() world positions sharing the height Z.
+	*	@param OutValues	As many as X and Y
+	*/
+	void EvaluateBatch(TArrayView<const double> X, TArrayView<const double> Y, double Z, TArrayView<float> OutValues) const;
+};
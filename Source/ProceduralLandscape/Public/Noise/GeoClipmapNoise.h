@@ -0,0 +1,71 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoClipmapNoise.generated.h"
+
+/** Noise material functions of BP/Noise/ImprovedPerlin */
+UENUM(BlueprintType)
+enum class EGeoClipmapNoiseType : uint8
+{
+	/*Single octave, inoise() of the material functions*/
+	Perlin UMETA(DisplayName = "Improved Perlin"),
+	FBM UMETA(DisplayName = "FBM"),
+	FBM_1TimeWarped UMETA(DisplayName = "FBM 1 time warped"),
+	FBM_2TimesWarped UMETA(DisplayName = "FBM 2 times warped"),
+	Ridged UMETA(DisplayName = "Ridged"),
+	Turbulence UMETA(DisplayName = "Turbulence"),
+};
+
+/*One noise material function used by the landscape material, defaults are the ones of the PerlinSettings collection*/
+USTRUCT(BlueprintType)
+struct PROCEDURALLANDSCAPE_API FGeoClipmapNoiseLayer
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		EGeoClipmapNoiseType Type = EGeoClipmapNoiseType::FBM;
+	/*World position is divided by PosScaling before being sampled*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float PosScaling = 201.243591f;
+	/*Truncated, as the Custom node does*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float Octave = 8.169151f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float Lacunarity = 2.017886f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float Gain = 0.489334f;
+	/*Added to the noise, except for Ridged where it is the ridge offset and Turbulence which ignores it*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float Offset = 0.701333f;
+	/*Height of the layer is (Noise - GlobalOffset) * Scale*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float GlobalOffset = 0.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+		float Scale = 150000.f;
+};
+
+/**
+*	CPU version of the ImprovedPerlin material functions, hashing through the same texels the GPU samples
+*	from T_permuTexture2d and T_permGradTexture so both agree up to float rounding.
+*	Batches are evaluated as structure of arrays, with AVX2 when the module is compiled for it and SSE/NEON otherwise.
+*/
+class PROCEDURALLANDSCAPE_API FGeoClipmapNoise
+{
+public:
+	/** Single octave noise at a position already divided by PosScaling */
+	static float ImprovedPerlin(const FVector3f& Position);
+
+	/** Noise of Layer at a world position, before GlobalOffset and Scale */
+	static float Evaluate(const FGeoClipmapNoiseLayer& Layer, const FVector& WorldPosition);
+
+	/**
+	*	Noise of Layer at X.Num() world positions sharing the height Z, before GlobalOffset and Scale.
+	*	@param OutValues	As many as X and Y
+	*/
+	static void EvaluateBatch(const FGeoClipmapNoiseLayer& Layer, TArrayView<const double> X, TArrayView<const double> Y, double Z, TArrayView<float> OutValues);
+
+	/** Noise of Layer at positions already divided by PosScaling, the UV input of the Custom nodes */
+	static void EvaluateUVBatch(const FGeoClipmapNoiseLayer& Layer, TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutValues);
+};
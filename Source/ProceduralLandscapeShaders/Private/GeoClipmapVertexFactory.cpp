@@ -0,0 +1,194 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "GeoClipmapVertexFactory.h"
+#include "MaterialShared.h"
+#include "MeshMaterialShader.h"
+#include "MeshDrawShaderBindings.h"
+#include "RHIResources.h"
+
+IMPLEMENT_GLOBAL_SHADER_PARAMETER_STRUCT(FGeoClipmapVertexFactoryParameters, "GeoClipmapVF");
+
+void FGeoClipmapCompactVertexBuffer::InitRHI()
+{
+	const uint32 SizeInBytes = Vertices.Num() * sizeof(FGeoClipmapCompactVertex);
+	if (SizeInBytes == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(TEXT("FGeoClipmapCompactVertexBuffer"));
+	VertexBufferRHI = RHICreateVertexBuffer(SizeInBytes, BUF_Static, CreateInfo);
+
+	void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, SizeInBytes, RLM_WriteOnly);
+	FMemory::Memcpy(VertexBufferData, Vertices.GetData(), SizeInBytes);
+	RHIUnlockVertexBuffer(VertexBufferRHI);
+}
+
+class FGeoClipmapVertexFactoryShaderParameters : public FVertexFactoryShaderParameters
+{
+	DECLARE_TYPE_LAYOUT(FGeoClipmapVertexFactoryShaderParameters, NonVirtual);
+
+public:
+	void GetElementShaderBindings(
+		const FSceneInterface* Scene,
+		const FSceneView* View,
+		const FMeshMaterialShader* Shader,
+		const EVertexInputStreamType InputStreamType,
+		ERHIFeatureLevel::Type FeatureLevel,
+		const FVertexFactory* VertexFactory,
+		const FMeshBatchElement& BatchElement,
+		FMeshDrawSingleShaderBindings& ShaderBindings,
+		FVertexInputStreamArray& VertexStreams) const
+	{
+		const FGeoClipmapVertexFactory* GeoClipmapVertexFactory = static_cast<const FGeoClipmapVertexFactory*>(VertexFactory);
+		ShaderBindings.Add(Shader->GetUniformBufferParameter<FGeoClipmapVertexFactoryParameters>(), GeoClipmapVertexFactory->GetUniformBuffer());
+	}
+};
+
+IMPLEMENT_TYPE_LAYOUT(FGeoClipmapVertexFactoryShaderParameters);
+
+FGeoClipmapVertexFactory::FGeoClipmapVertexFactory(ERHIFeatureLevel::Type InFeatureLevel)
+	: FVertexFactory(InFeatureLevel)
+{
+}
+
+bool FGeoClipmapVertexFactory::ShouldCompilePermutation(const FVertexFactoryShaderPermutationParameters& Parameters)
+{
+	return Parameters.MaterialParameters.MaterialDomain == MD_Surface || Parameters.MaterialParameters.bIsSpecialEngineMaterial;
+}
+
+void FGeoClipmapVertexFactory::ModifyCompilationEnvironment(const FVertexFactoryShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FVertexFactory::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+}
+
+void FGeoClipmapVertexFactory::SetData(const FGeoClipmapCompactVertexBuffer* InVertexBuffer, float InVerticalJitter)
+{
+	VertexBuffer = InVertexBuffer;
+	VerticalJitter = InVerticalJitter;
+}
+
+void FGeoClipmapVertexFactory::InitRHI()
+{
+	check(VertexBuffer);
+
+	// Grid coordinates and flags, read as int4 by the shader
+	const FVertexStreamComponent CompactComponent(VertexBuffer, 0, sizeof(FGeoClipmapCompactVertex), VET_Short4);
+
+	FVertexDeclarationElementList Elements;
+	Elements.Add(AccessStreamComponent(CompactComponent, 0));
+	InitDeclaration(Elements);
+
+	// The same stream carries the position for depth only passes
+	FVertexDeclarationElementList PositionOnlyElements;
+	PositionOnlyElements.Add(AccessStreamComponent(CompactComponent, 0, EVertexInputStreamType::PositionOnly));
+	InitDeclaration(PositionOnlyElements, EVertexInputStreamType::PositionOnly);
+
+	InitUniformBuffer();
+}
+
+void FGeoClipmapVertexFactory::InitUniformBuffer()
+{
+	FGeoClipmapVertexFactoryParameters Parameters;
+	Parameters.VerticalJitter = VerticalJitter;
+	Parameters.NumPatches = Patches.Num();
+	for (int32 PatchIndex = 0; PatchIndex < GEOCLIPMAP_MAX_GRID_PATCHES; PatchIndex++)
+	{
+		if (Patches.IsValidIndex(PatchIndex))
+		{
+			const FGeoClipmapGridPatch& Patch = Patches[PatchIndex];
+			Parameters.Patches[PatchIndex] = FIntVector4(Patch.FirstVertex, Patch.NumX | Patch.NumY << 16, Patch.Offset.X, Patch.Offset.Y);
+		}
+		else
+		{
+			Parameters.Patches[PatchIndex] = FIntVector4(MAX_int32, 0, 0, 0);
+		}
+	}
+	UniformBuffer = FGeoClipmapVertexFactoryBufferRef::CreateUniformBufferImmediate(Parameters, UniformBuffer_MultiFrame);
+}
+
+void FGeoClipmapVertexFactory::ReleaseRHI()
+{
+	UniformBuffer.SafeRelease();
+	FVertexFactory::ReleaseRHI();
+}
+
+FGeoClipmapBufferlessVertexFactory::FGeoClipmapBufferlessVertexFactory(ERHIFeatureLevel::Type InFeatureLevel)
+	: FGeoClipmapVertexFactory(InFeatureLevel)
+{
+}
+
+void FGeoClipmapBufferlessVertexFactory::ModifyCompilationEnvironment(const FVertexFactoryShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FGeoClipmapVertexFactory::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	OutEnvironment.SetDefine(TEXT("GEOCLIPMAP_BUFFERLESS"), 1);
+}
+
+void FGeoClipmapBufferlessVertexFactory::SetData(const TArray<FGeoClipmapGridPatch>& InPatches, float InVerticalJitter)
+{
+	check(InPatches.Num() <= GEOCLIPMAP_MAX_GRID_PATCHES);
+	Patches = InPatches;
+	VerticalJitter = InVerticalJitter;
+}
+
+void FGeoClipmapBufferlessVertexFactory::InitRHI()
+{
+	// Vertices come from SV_VertexID only
+	FVertexDeclarationElementList Elements;
+	InitDeclaration(Elements);
+
+	InitUniformBuffer();
+}
+
+/** FLocalVertexFactoryShaderParameters, which is not exported */
+class FGeoClipmapLocalVertexFactoryShaderParameters : public FLocalVertexFactoryShaderParametersBase
+{
+	DECLARE_TYPE_LAYOUT(FGeoClipmapLocalVertexFactoryShaderParameters, NonVirtual);
+
+public:
+	void GetElementShaderBindings(
+		const FSceneInterface* Scene,
+		const FSceneView* View,
+		const FMeshMaterialShader* Shader,
+		const EVertexInputStreamType InputStreamType,
+		ERHIFeatureLevel::Type FeatureLevel,
+		const FVertexFactory* VertexFactory,
+		const FMeshBatchElement& BatchElement,
+		FMeshDrawSingleShaderBindings& ShaderBindings,
+		FVertexInputStreamArray& VertexStreams) const
+	{
+		const FLocalVertexFactory* LocalVertexFactory = static_cast<const FLocalVertexFactory*>(VertexFactory);
+		GetElementShaderBindingsBase(Scene, View, Shader, InputStreamType, FeatureLevel, VertexFactory, BatchElement, LocalVertexFactory->GetUniformBuffer(), ShaderBindings, VertexStreams);
+	}
+};
+
+IMPLEMENT_TYPE_LAYOUT(FGeoClipmapLocalVertexFactoryShaderParameters);
+
+IMPLEMENT_VERTEX_FACTORY_PARAMETER_TYPE(FGeoClipmapVertexFactory, SF_Vertex, FGeoClipmapVertexFactoryShaderParameters);
+IMPLEMENT_VERTEX_FACTORY_PARAMETER_TYPE(FGeoClipmapBufferlessVertexFactory, SF_Vertex, FGeoClipmapVertexFactoryShaderParameters);
+IMPLEMENT_VERTEX_FACTORY_PARAMETER_TYPE(FGeoClipmapLocalVertexFactory, SF_Vertex, FGeoClipmapLocalVertexFactoryShaderParameters);
+
+IMPLEMENT_VERTEX_FACTORY_TYPE(FGeoClipmapVertexFactory, "/Plugin/ProceduralLandscape/Private/GeoClipmapVertexFactory.ush",
+	EVertexFactoryFlags::UsedWithMaterials
+	| EVertexFactoryFlags::SupportsDynamicLighting
+	| EVertexFactoryFlags::SupportsPositionOnly
+	| EVertexFactoryFlags::SupportsCachingMeshDrawCommands
+);
+
+IMPLEMENT_VERTEX_FACTORY_TYPE(FGeoClipmapBufferlessVertexFactory, "/Plugin/ProceduralLandscape/Private/GeoClipmapVertexFactory.ush",
+	EVertexFactoryFlags::UsedWithMaterials
+	| EVertexFactoryFlags::SupportsDynamicLighting
+	| EVertexFactoryFlags::SupportsCachingMeshDrawCommands
+);
+
+// The flags of FLocalVertexFactory but SupportsPrimitiveIdStream, its shader then reads the Primitive uniform buffer of the batch
+IMPLEMENT_VERTEX_FACTORY_TYPE(FGeoClipmapLocalVertexFactory, "/Engine/Private/LocalVertexFactory.ush",
+	EVertexFactoryFlags::UsedWithMaterials
+	| EVertexFactoryFlags::SupportsStaticLighting
+	| EVertexFactoryFlags::SupportsDynamicLighting
+	| EVertexFactoryFlags::SupportsPrecisePrevWorldPos
+	| EVertexFactoryFlags::SupportsPositionOnly
+	| EVertexFactoryFlags::SupportsCachingMeshDrawCommands
+	| EVertexFactoryFlags::SupportsRayTracing
+	| EVertexFactoryFlags::SupportsRayTracingDynamicGeometry
+);
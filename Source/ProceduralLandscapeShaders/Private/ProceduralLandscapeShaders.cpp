@@ -0,0 +1,19 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#include "ProceduralLandscapeShaders.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "ShaderCore.h"
+
+void FProceduralLandscapeShadersModule::StartupModule()
+{
+	// Shaders of the clipmap vertex factories, the mapping has to exist before their types are registered
+	FString PluginShaderDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("ProceduralLandscape"))->GetBaseDir(), TEXT("Shaders"));
+	AddShaderSourceDirectoryMapping(TEXT("/Plugin/ProceduralLandscape"), PluginShaderDir);
+}
+
+void FProceduralLandscapeShadersModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FProceduralLandscapeShadersModule, ProceduralLandscapeShaders)
@@ -0,0 +1,98 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+#include "VertexFactory.h"
+#include "LocalVertexFactory.h"
+#include "ShaderParameterMacros.h"
+#include "GeoClipmapVertexTypes.h"
+
+BEGIN_GLOBAL_SHADER_PARAMETER_STRUCT(FGeoClipmapVertexFactoryParameters, PROCEDURALLANDSCAPESHADERS_API)
+	SHADER_PARAMETER(float, VerticalJitter)
+	SHADER_PARAMETER(int32, NumPatches)
+	/** Bufferless only, x FirstVertex, y NumX | NumY << 16, zw grid coordinates of the first vertex */
+	SHADER_PARAMETER_ARRAY(FIntVector4, Patches, [GEOCLIPMAP_MAX_GRID_PATCHES])
+END_GLOBAL_SHADER_PARAMETER_STRUCT()
+
+typedef TUniformBufferRef<FGeoClipmapVertexFactoryParameters> FGeoClipmapVertexFactoryBufferRef;
+
+/** GPU copy of FGeoCProcMeshSection::CompactVertexBuffer */
+class PROCEDURALLANDSCAPESHADERS_API FGeoClipmapCompactVertexBuffer : public FVertexBuffer
+{
+public:
+	TArray<FGeoClipmapCompactVertex> Vertices;
+
+	virtual void InitRHI() override;
+	virtual FString GetFriendlyName() const override { return TEXT("FGeoClipmapCompactVertexBuffer"); }
+};
+
+/**
+*	Vertex factory of compact clipmap sections.
+*	Vertices are int16 grid coordinates plus flags, the shader rebuilds the position and the UVs the clipmap materials read :
+*	UV0 Frac(Grid/400000), UV1 Grid coordinates, UV2.x interior flag. See Shaders/Private/GeoClipmapVertexFactory.ush
+*/
+class PROCEDURALLANDSCAPESHADERS_API FGeoClipmapVertexFactory : public FVertexFactory
+{
+	DECLARE_VERTEX_FACTORY_TYPE(FGeoClipmapVertexFactory);
+
+public:
+	FGeoClipmapVertexFactory(ERHIFeatureLevel::Type InFeatureLevel);
+
+	static bool ShouldCompilePermutation(const FVertexFactoryShaderPermutationParameters& Parameters);
+	static void ModifyCompilationEnvironment(const FVertexFactoryShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+
+	/** Set before the resource is initialized */
+	void SetData(const FGeoClipmapCompactVertexBuffer* InVertexBuffer, float InVerticalJitter);
+
+	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+
+	const FGeoClipmapVertexFactoryBufferRef& GetUniformBuffer() const { return UniformBuffer; }
+
+protected:
+	/** Render thread, create the uniform buffer from VerticalJitter and Patches */
+	void InitUniformBuffer();
+
+	const FGeoClipmapCompactVertexBuffer* VertexBuffer = nullptr;
+	float VerticalJitter = 0.f;
+	TArray<FGeoClipmapGridPatch> Patches;
+	FGeoClipmapVertexFactoryBufferRef UniformBuffer;
+};
+
+/**
+*	Vertex factory of bufferless clipmap sections, no vertex stream is bound.
+*	The shader finds the grid patch SV_VertexID belongs to and rebuilds the same vertex FGeoClipmapVertexFactory reads from its compact buffer.
+*/
+class PROCEDURALLANDSCAPESHADERS_API FGeoClipmapBufferlessVertexFactory final : public FGeoClipmapVertexFactory
+{
+	DECLARE_VERTEX_FACTORY_TYPE(FGeoClipmapBufferlessVertexFactory);
+
+public:
+	FGeoClipmapBufferlessVertexFactory(ERHIFeatureLevel::Type InFeatureLevel);
+
+	static void ModifyCompilationEnvironment(const FVertexFactoryShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+
+	/** Set before the resource is initialized */
+	void SetData(const TArray<FGeoClipmapGridPatch>& InPatches, float InVerticalJitter);
+
+	virtual void InitRHI() override;
+};
+
+/**
+*	Local vertex factory of full format clipmap sections, without GPU Scene support.
+*	Its shaders read the primitive uniform buffer of each batch, so the sections of a level can be drawn from cached
+*	mesh draw commands with the level buffer of the proxy, which is updated in place when the level moves.
+*	With GPU Scene, FLocalVertexFactory would read the component transform from the scene instead.
+*/
+class PROCEDURALLANDSCAPESHADERS_API FGeoClipmapLocalVertexFactory final : public FLocalVertexFactory
+{
+	DECLARE_VERTEX_FACTORY_TYPE(FGeoClipmapLocalVertexFactory);
+
+public:
+	FGeoClipmapLocalVertexFactory(ERHIFeatureLevel::Type InFeatureLevel, const char* InDebugName)
+		: FLocalVertexFactory(InFeatureLevel, InDebugName)
+	{
+	}
+};
@@ -0,0 +1,62 @@
+//Copyright Maxime Dupart 2021  https://twitter.com/Max_Dupt
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+*	Compact clipmap vertex, 8 bytes instead of a full FGeoCProcMeshVertex.
+*	Position is implied by the grid coordinates and the component transform, UVs are rebuilt by FGeoClipmapVertexFactory.
+*/
+struct FGeoClipmapCompactVertex
+{
+	/** Grid coordinates, in GridSpacing units */
+	int16 X;
+	int16 Y;
+	/** EGeoClipmapCompactVertexFlags */
+	uint16 Flags;
+	uint16 Padding;
+};
+
+enum EGeoClipmapCompactVertexFlags : uint16
+{
+	/** Vertex is not on the border of its grid, the former UV2.x */
+	GeoClipmapVertex_Interior = 1 << 0,
+	/** Vertex is pushed down by the vertical jitter instead of up */
+	GeoClipmapVertex_JitterDown = 1 << 1,
+};
+
+/** Maximum number of grid patches of a bufferless section, every section of a ring together is made of 15 */
+#define GEOCLIPMAP_MAX_GRID_PATCHES 16
+
+/**
+*	Regular grid of a bufferless section.
+*	Vertices follow the ones of the previous patches, in row major order, FGeoClipmapBufferlessVertexFactory rebuilds them from SV_VertexID.
+*/
+struct FGeoClipmapGridPatch
+{
+	/** Index of the first vertex of this patch in its section */
+	int32 FirstVertex = 0;
+	int32 NumX = 0;
+	int32 NumY = 0;
+	/** Grid coordinates of the first vertex, in GridSpacing units */
+	FIntPoint Offset = FIntPoint::ZeroValue;
+	/** Stitching of the patch borders, see FGeoClipmapRingGeometryKey */
+	uint8 StitchProfile = 0;
+
+	int32 GetNumVertices() const { return NumX * NumY; }
+
+	/** Compact equivalent of one vertex of the patch, LocalIndex being relative to FirstVertex */
+	FGeoClipmapCompactVertex GetCompactVertex(int32 LocalIndex) const
+	{
+		const int32 i = LocalIndex / NumX;
+		const int32 j = LocalIndex - i * NumX;
+
+		FGeoClipmapCompactVertex Vertex;
+		Vertex.X = (int16)(Offset.X + j);
+		Vertex.Y = (int16)(Offset.Y + i);
+		Vertex.Flags = ((i > 0 && i < NumY - 1) && (j > 0 && j < NumX - 1) ? GeoClipmapVertex_Interior : 0) | ((i + j) % 2 == 0 ? 0 : GeoClipmapVertex_JitterDown);
+		Vertex.Padding = 0;
+		return Vertex;
+	}
+};